@@ -0,0 +1,286 @@
+// COMP2521 21T2 Assignment 1
+// BookText.c ... implementation of whole-book text loading
+// z5361442 James Teng
+/* The Gutenberg markers are found with memmem on "*** " rather than by
+reading line by line, and only matches at the start of a line count.
+A stream is scanned one buffer at a time. Each buffer is cut after its last
+newline (or, for a line longer than the whole buffer, its last space), so
+neither a word nor a marker line is split between two pieces; the bytes
+after the cut are moved to the front and read onto. */
+
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BookText.h"
+
+#define READ_CHUNK 65536
+
+static const char MARKER[] = "*** ";
+static const char BEGIN[] = "*** START OF";
+static const char END[] = "*** END OF";
+
+// how far stream_body has got through the book
+typedef enum {
+	BEFORE_BODY,
+	START_LINE,      // in the rest of the "*** START OF" line
+	IN_BODY,
+	AFTER_BODY,
+	NO_BODY,         // the END line came first
+} StreamState;
+
+// ************************ function prototypes ********************************
+static bool map_file(int fd, BookText *book);
+static bool read_stream(int fd, BookText *book);
+static BookStatus stream_body(int fd, BookPieceFn piece, void *ctx);
+static size_t stream_cut(const char *buffer, size_t length);
+static StreamState scan_piece(const char *begin, const char *end,
+                              bool line_start, StreamState state,
+                              BookPieceFn piece, void *ctx);
+static const char *next_marker(const char *from, const char *limit,
+                               const char *text_start, bool line_start);
+static bool line_starts_with(const char *line, const char *limit, const char *prefix);
+// ************************ end of function prototypes *************************
+
+bool BookTextOpen(char *fileName, BookText *book) {
+	bool use_stdin = strcmp(fileName, "-") == 0;
+	int fd = use_stdin ? STDIN_FILENO : open(fileName, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	bool ok = true;
+	// fall back to reading the whole stream
+	if (!map_file(fd, book)) {
+		ok = read_stream(fd, book);
+	}
+	if (!use_stdin) {
+		close(fd);
+	}
+	return ok;
+}
+
+void BookTextClose(BookText *book) {
+	if (book->mapped) {
+		munmap((void *)book->data, book->length);
+	}
+	else {
+		free((void *)book->data);
+	}
+	book->data = NULL;
+	book->length = 0;
+}
+
+bool BookTextBody(BookText *book, const char **begin, const char **end) {
+	const char *text = book->data;
+	const char *limit = text + book->length;
+	const char *body = NULL;
+
+	for (const char *line = next_marker(text, limit, text, true); line != NULL;
+	     line = next_marker(line + 1, limit, text, true)) {
+		// checks if the current line matches the starting string
+		if (body == NULL && line_starts_with(line, limit, BEGIN)) {
+			// the text starts on the line after the starting string
+			const char *newline = memchr(line, '\n', limit - line);
+			body = newline != NULL ? newline + 1 : limit;
+		}
+		// checks if the current line matches the ending string
+		else if (line_starts_with(line, limit, END)) {
+			if (body == NULL) {
+				return false;
+			}
+			*begin = body;
+			*end = line;
+			return true;
+		}
+	}
+	return false;
+}
+
+BookStatus BookTextForEachPiece(char *fileName, BookPieceFn piece, void *ctx) {
+	bool use_stdin = strcmp(fileName, "-") == 0;
+	int fd = use_stdin ? STDIN_FILENO : open(fileName, O_RDONLY);
+	if (fd < 0) {
+		return BOOK_UNREADABLE;
+	}
+	BookStatus status;
+	BookText book;
+	if (map_file(fd, &book)) {
+		const char *begin;
+		const char *end;
+		status = BookTextBody(&book, &begin, &end) ? BOOK_OK
+		                                           : BOOK_NOT_GUTENBERG;
+		if (status == BOOK_OK) {
+			piece(begin, end, ctx);
+		}
+		BookTextClose(&book);
+	}
+	else {
+		status = stream_body(fd, piece, ctx);
+	}
+	if (!use_stdin) {
+		close(fd);
+	}
+	return status;
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// maps the file if it is a non-empty regular file; returns false if not
+static bool map_file(int fd, BookText *book) {
+	book->data = NULL;
+	book->length = 0;
+	book->mapped = false;
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+		return false;
+	}
+	void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (map == MAP_FAILED) {
+		return false;
+	}
+	// the book is read once from front to back
+	madvise(map, info.st_size, MADV_SEQUENTIAL);
+	book->data = map;
+	book->length = info.st_size;
+	book->mapped = true;
+	return true;
+}
+
+// reads everything left in the stream into a malloc'd buffer
+static bool read_stream(int fd, BookText *book) {
+	size_t capacity = READ_CHUNK;
+	size_t length = 0;
+	char *data = malloc(capacity);
+	assert(data != NULL);
+	while (true) {
+		if (length == capacity) {
+			capacity *= 2;
+			data = realloc(data, capacity);
+			assert(data != NULL);
+		}
+		ssize_t got = read(fd, data + length, capacity - length);
+		if (got < 0) {
+			free(data);
+			return false;
+		}
+		if (got == 0) break;
+		length += got;
+	}
+	book->data = data;
+	book->length = length;
+	return true;
+}
+
+// reads the book's text from the stream a buffer at a time, passing each
+// buffer's share of the text to `piece`
+static BookStatus stream_body(int fd, BookPieceFn piece, void *ctx) {
+	char *buffer = malloc(BOOK_STREAM_BUFFER);
+	assert(buffer != NULL);
+	size_t length = 0;         // bytes in the buffer
+	bool line_start = true;    // if the buffer starts at the start of a line
+	StreamState state = BEFORE_BODY;
+	bool eof = false;
+	while (!eof && state != AFTER_BODY && state != NO_BODY) {
+		ssize_t got = read(fd, buffer + length, BOOK_STREAM_BUFFER - length);
+		if (got < 0) {
+			free(buffer);
+			return BOOK_UNREADABLE;
+		}
+		eof = got == 0;
+		length += got;
+		// reads from a pipe can be short, so fill the buffer first
+		if (!eof && length < BOOK_STREAM_BUFFER) continue;
+
+		size_t cut = eof ? length : stream_cut(buffer, length);
+		state = scan_piece(buffer, buffer + cut, line_start, state, piece, ctx);
+		if (cut > 0) {
+			line_start = buffer[cut - 1] == '\n';
+		}
+		memmove(buffer, buffer + cut, length - cut);
+		length -= cut;
+	}
+	free(buffer);
+	return state == AFTER_BODY ? BOOK_OK : BOOK_NOT_GUTENBERG;
+}
+
+// returns where to cut a full buffer: after the last newline, or the last
+// space or tab if there is no newline, or at the end if there is neither
+static size_t stream_cut(const char *buffer, size_t length) {
+	for (size_t i = length; i > 0; i--) {
+		if (buffer[i - 1] == '\n') return i;
+	}
+	for (size_t i = length; i > 0; i--) {
+		if (buffer[i - 1] == ' ' || buffer[i - 1] == '\t') return i;
+	}
+	return length;
+}
+
+// looks for the marker lines between `begin` and `end` (one piece of a
+// stream), passing on any of the book's text in it, and returns how far
+// through the book the end of the piece is
+static StreamState scan_piece(const char *begin, const char *end,
+                              bool line_start, StreamState state,
+                              BookPieceFn piece, void *ctx) {
+	const char *text = begin;
+	if (state == START_LINE) {
+		const char *newline = memchr(begin, '\n', end - begin);
+		if (newline == NULL) {
+			return START_LINE;
+		}
+		text = newline + 1;
+		state = IN_BODY;
+	}
+	for (const char *line = next_marker(text, end, begin, line_start);
+	     line != NULL; line = next_marker(line + 1, end, begin, line_start)) {
+		if (state == BEFORE_BODY && line_starts_with(line, end, BEGIN)) {
+			// the text starts on the line after the starting string
+			const char *newline = memchr(line, '\n', end - line);
+			if (newline == NULL) {
+				return START_LINE;
+			}
+			text = newline + 1;
+			state = IN_BODY;
+		}
+		else if (line_starts_with(line, end, END)) {
+			if (state == BEFORE_BODY) {
+				return NO_BODY;
+			}
+			piece(text, line, ctx);
+			return AFTER_BODY;
+		}
+	}
+	if (state == IN_BODY && text < end) {
+		piece(text, end, ctx);
+	}
+	return state;
+}
+
+// returns the next "*** " at the start of a line, at or after `from`.
+// `line_start` says whether `text_start` is at the start of a line.
+static const char *next_marker(const char *from, const char *limit,
+                               const char *text_start, bool line_start) {
+	while (from < limit) {
+		const char *found = memmem(from, limit - from, MARKER, strlen(MARKER));
+		if (found == NULL) {
+			return NULL;
+		}
+		if (found == text_start ? line_start : found[-1] == '\n') {
+			return found;
+		}
+		from = found + 1;
+	}
+	return NULL;
+}
+
+static bool line_starts_with(const char *line, const char *limit, const char *prefix) {
+	size_t length = strlen(prefix);
+	return (size_t)(limit - line) >= length && memcmp(line, prefix, length) == 0;
+}
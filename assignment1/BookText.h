@@ -0,0 +1,57 @@
+// COMP2521 21T2 Assignment 1
+// BookText.h ... interface to whole-book text loading
+// z5361442 James Teng
+// Gives read-only access to the contents of a book file. Regular files are
+// memory mapped, so no bytes are copied. Anything that cannot be mapped
+// (pipes, terminals, "-" for standard input) is either read into memory
+// whole by BookTextOpen, which is only meant for small files, or read a
+// bounded buffer at a time by BookTextForEachPiece.
+
+#ifndef BOOKTEXT_H
+#define BOOKTEXT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// bytes of a stream held in memory at once by BookTextForEachPiece
+#define BOOK_STREAM_BUFFER (4 << 20)
+
+typedef enum {
+	BOOK_OK,
+	BOOK_UNREADABLE,       // the file can't be opened or read
+	BOOK_NOT_GUTENBERG,    // the START or END line is missing
+} BookStatus;
+
+// Called with consecutive pieces of a book's text. Every piece ends
+// between two words; the bytes are only valid during the call.
+typedef void (*BookPieceFn)(const char *begin, const char *end, void *ctx);
+
+typedef struct BookText {
+	const char *data;   // contents of the file (not NUL-terminated)
+	size_t length;
+	bool mapped;        // true if data is an mmap of the file
+} BookText;
+
+// Loads the named file ("-" means standard input). Returns false if the
+// file can't be opened or read. A stream is read into memory whole.
+bool BookTextOpen(char *fileName, BookText *book);
+
+// Releases the contents of the given book
+void BookTextClose(BookText *book);
+
+// Finds the text of a Project Gutenberg book: everything after the line
+// starting with "*** START OF" up to the line starting with "*** END OF".
+// Stores the bounds in `begin`/`end` and returns true, or returns false if
+// either line is missing or the end line comes first.
+bool BookTextBody(BookText *book, const char **begin, const char **end);
+
+// Passes the text of the named Project Gutenberg book (as found by
+// BookTextBody) to `piece`. A regular file is mapped and passed in one
+// piece; a stream is read BOOK_STREAM_BUFFER bytes at a time, with the
+// unfinished last line of each read carried over to the next, so memory
+// use does not grow with the stream. Pieces of a stream are passed as
+// they are read, so some may have been passed before BOOK_NOT_GUTENBERG
+// is returned.
+BookStatus BookTextForEachPiece(char *fileName, BookPieceFn piece, void *ctx);
+
+#endif
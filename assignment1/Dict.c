@@ -1,10 +1,12 @@
 // COMP2521 21T2 Assignment 1
 // Dict.c ... implementation of the Dictionary ADT
 // z5361442 James Teng - written in July 2021
-/* This file provides functions for a Binary Search Tree implementation. 
-It also provides functions to add nodes in a BST to a temporary array, then 
-sorts this array and inserts the first n entries in this array into the given 
-"wfs" array */
+/* This file provides functions for a Binary Search Tree implementation.
+It also provides functions to pass nodes in a BST through a bounded heap that
+keeps the n most frequent words, which are then stored in the given "wfs"
+array. The nodes and their words are allocated from a string arena, so the
+whole tree is freed at once and the words returned by DictFindTopN stay valid
+until DictFree. */
 
 #include <assert.h>
 #include <stdbool.h>
@@ -13,30 +15,40 @@ sorts this array and inserts the first n entries in this array into the given
 #include <string.h>
 
 #include "Dict.h"
+#include "DictExt.h"
+#include "StrArena.h"
+#include "TopN.h"
 #include "WFreq.h"
 
 // you may define your own structs here
-struct DictRep {
+typedef struct Node *Node;
+struct Node {
 	char *data;
 	int word_count;
-	Dict left;
-	Dict right;
+	Node left;
+	Node right;
+};
+
+struct DictRep {
+	Node root;
+	StrArena arena;      // holds every node and word in the tree
 };
 
 // ************************ function prototypes ********************************
-static void show_BST_node(Dict d);
-Dict return_insert(Dict d, char *word);
+static void show_BST_node(Node n);
+static void show_tree(Node n);
+Node return_insert(Dict d, Node n, char *word, int count);
+static int find_word(Node n, char *word);
+static void visit_tree(Node n, DictVisitFn visit, void *ctx);
 
-int cmp_func(const void * a, const void * b);
-void tree_to_array(Dict d, WFreq *all_words, int *i);
-int order_sorter(const void *object_1, const void *object_2);
+void tree_to_topn(Node n, TopN best);
 // ************************ end of function prototypes *************************
 // Creates a new Dictionary
 Dict DictNew(void) {
 	Dict d = malloc(sizeof(struct DictRep));
-	d->left = NULL;
-	d->right = NULL;
-	d->word_count = 0;
+	assert(d != NULL);
+	d->root = NULL;
+	d->arena = StrArenaNew();
 	return d;
 }
 
@@ -45,76 +57,99 @@ void DictFree(Dict d) {
 	if (d == NULL) {
 		return;
 	}
-	if (d->left != NULL) {
-		DictFree(d->left);
-	}
-	if (d->right != NULL) {
-		DictFree(d->right);
-	}
-	free(d->data);
+	// every node and word is in the arena
+	StrArenaFree(d->arena);
 	free(d);
 }
 
+// Removes every word from the Dictionary
+void DictClear(Dict d) {
+	StrArenaReset(d->arena);
+	d->root = NULL;
+}
+
 // Inserts an occurrence of the given word into the Dictionary
 void DictInsert(Dict d, char *word) {
-    // if root node is empty
-    if (d->word_count == 0) {
-        d->data = strdup(word);
-        d->word_count = 1;
-        return;
-    }
-	return_insert(d, word);
+	DictAdd(d, word, 1);
+}
+
+// Adds `count` occurrences of the given word to the Dictionary
+void DictAdd(Dict d, char *word, int count) {
+	d->root = return_insert(d, d->root, word, count);
 }
 
-// helper function for the DictInsert function
-Dict return_insert(Dict d, char *word) {
-    if (d == NULL) {
+// helper function for the DictAdd function
+Node return_insert(Dict d, Node n, char *word, int count) {
+    if (n == NULL) {
         //create new node and store word within this node
-		Dict new_node = DictNew();
-        new_node->data = strdup(word);
-		new_node->word_count = 1;
+		Node new_node = StrArenaAlloc(d->arena, sizeof(struct Node));
+        new_node->data = StrArenaCopy(d->arena, word, strlen(word));
+		new_node->word_count = count;
+		new_node->left = NULL;
+		new_node->right = NULL;
 		return new_node;
 	}
-	int compare = strcmp(word, d->data);
+	int compare = strcmp(word, n->data);
 	// if word is lexicographically smaller than node's word
 	if (compare < 0) {
-		d->left = return_insert(d->left, word);
+		n->left = return_insert(d, n->left, word, count);
 	}
 	// if word is lexicographically larger than node's word
 	else if (compare > 0) {
-		d->right = return_insert(d->right, word);
+		n->right = return_insert(d, n->right, word, count);
 	}
 	// if word is already in dictionary
 	else if (compare == 0) {
-		d->word_count++;
-		return d;
+		n->word_count += count;
+		return n;
 	}
-	return d;
+	return n;
 }
 
 // Returns the occurrence count of the given word. Returns 0 if the word
 // is not in the Dictionary.
 int DictFind(Dict d, char *word) {
+	return find_word(d->root, word);
+}
+
+// helper function for the DictFind function
+static int find_word(Node n, char *word) {
 	// if word is not found
-	if (d == NULL) {
+	if (n == NULL) {
 		return 0;
 	}
-	int compare = strcmp(word, d->data);
+	int compare = strcmp(word, n->data);
 	// if word is lexicographically smaller than node's word
 	if (compare < 0) {
-		return DictFind(d->left, word);
+		return find_word(n->left, word);
 	}
 	// if word is lexicographically larger than node's word
 	else if (compare > 0) {
-		return DictFind(d->right, word);
+		return find_word(n->right, word);
 	}
 	// if word has been found in dictionary
 	else if (compare == 0) {
-		return d->word_count;
+		return n->word_count;
 	}
 	return 0;
 }
 
+// Calls `visit` for every word in the Dictionary. The tree is walked in
+// pre-order, not in order, so adding the words to an empty tree in the
+// order they are visited rebuilds the same shape instead of a linked list.
+void DictForEach(Dict d, DictVisitFn visit, void *ctx) {
+	visit_tree(d->root, visit, ctx);
+}
+
+static void visit_tree(Node n, DictVisitFn visit, void *ctx) {
+	if (n == NULL) {
+		return;
+	}
+	visit(n->data, n->word_count, ctx);
+	visit_tree(n->left, visit, ctx);
+	visit_tree(n->right, visit, ctx);
+}
+
 // Finds  the top `n` frequently occurring words in the given Dictionary
 // and stores them in the given  `wfs`  array  in  decreasing  order  of
 // frequency,  and then in increasing lexicographic order for words with
@@ -123,71 +158,25 @@ int DictFind(Dict d, char *word) {
 // Dictionary  does  not  contain enough words to fill the entire array.
 // Assumes that the `wfs` array has size `n`.
 int DictFindTopN(Dict d, WFreq *wfs, int n) {
-	// declare a temporary array to hold all words in the BST
-	WFreq all_words[50000];
-	int j = 0;
-	// reads all words in the BST into the all_words array
-	tree_to_array(d, all_words, &j);
-	// sorting algorithm to sort all_words array from largest frequency 
-	//to lowest frequency
-	qsort(all_words, j, sizeof(WFreq), order_sorter);
-	int i = 0;
-	// update the wfs array with the top n words from the all_words array
-	while (i < j && i < n) {
-		wfs[i].word = all_words[i].word;
-		wfs[i].freq = all_words[i].freq;
-		i++;
-	}
+	// keep the best n words seen so far in a bounded heap
+	TopN best = TopNNew(n);
+	// offers all words in the BST to the heap
+	tree_to_topn(d->root, best);
+	// sort the kept words from largest frequency to lowest frequency
+	int i = TopNFinish(best, wfs);
+	TopNFree(best);
 	return i;
 }
 
 // ******************START OF HELPER FUNCTIONS FOR DictFindTopN*****************
-// compare function for qsort
-// determines the order to sort the array 
-int order_sorter(const void *object_1, const void *object_2) {
-	WFreq *node_1 = (WFreq *)object_1;
-	WFreq *node_2 = (WFreq *)object_2;
-
-    // if new node is higher frequency than current node, then we insert 
-	// new_node in front of the current node
-    if (node_1->freq > node_2->freq) {
-        return 0;
-    }
-    // if new node is lower frequency than current node, then we insert new_node
-    // behind the current node
-    else if (node_1->freq < node_2->freq) {
-        return 1;
-    }
-    // if new node has the same frequency as the current node, then we need to 
-	// sort alphabetically
-    else if (node_1->freq == node_2->freq) {
-        int compare = strcmp(node_1->word, node_2->word);
-        // if new node is lexicographically smaller than curr node, then we 
-        // insert new_node before the current node
-        if (compare < 0) {
-            return 0;
-        }
-        // if new node is lexicographically bigger than curr node, then we 
-		// insert after the current node
-        else if (compare > 0) {
-            return 1;
-        }
-    }
-    return -1;
-}
-
-// traverses the tree recursively, to store nodes in the tree into a given array
-void tree_to_array(Dict d, WFreq *all_words, int *j) {
-	if (d == NULL) {
+// traverses the tree recursively, offering every node to the top-n selector
+void tree_to_topn(Node n, TopN best) {
+	if (n == NULL) {
 		return;
 	}
-	tree_to_array(d->left, all_words, j);
-	tree_to_array(d->right, all_words, j);
-	// stores word in array
-	all_words[*j].word = d->data;
-	// stores frequency of word in array
-	all_words[*j].freq = d->word_count;
-	(*j)++;
+	tree_to_topn(n->left, best);
+	tree_to_topn(n->right, best);
+	TopNOffer(best, n->data, n->word_count);
 }
 
 // ******************END OF HELPER FUNCTIONS FOR DictFindTopN*****************
@@ -196,14 +185,18 @@ void tree_to_array(Dict d, WFreq *all_words, int *j) {
 // so  you  may  display the Dictionary in any format you want.  You may
 // choose not to implement this.
 void DictShow(Dict d) {
-	if (d == NULL) return;
+	show_tree(d->root);
+}
+
+static void show_tree(Node n) {
+	if (n == NULL) return;
 
-    DictShow(d->left);
-    show_BST_node(d);
-    DictShow(d->right);
+    show_tree(n->left);
+    show_BST_node(n);
+    show_tree(n->right);
 }
 
-static void show_BST_node(Dict d) {
-    if (d == NULL) return;
-    printf("%s ", d->data);
-}
\ No newline at end of file
+static void show_BST_node(Node n) {
+    if (n == NULL) return;
+    printf("%s ", n->data);
+}
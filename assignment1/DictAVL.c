@@ -0,0 +1,237 @@
+// COMP2521 21T2 Assignment 1
+// DictAVL.c ... AVL tree implementation of the Dictionary ADT
+// z5361442 James Teng
+/* Alternative to Dict.c behind the same Dict.h interface. The tree is kept
+height balanced (AVL), so sorted input such as word lists no longer turns it
+into a linked list: its height is at most about 1.44 log2(n), and inserts
+and lookups are O(log n). Insert and find are loops rather than recursion;
+insert records the links it followed on a small fixed stack and rebalances
+on the way back up. Words are kept in order, so DictForEach and DictShow
+visit them alphabetically. Nodes and words live in a string arena, as in
+Dict.c. Link tw against DictAVL.o instead of Dict.o to use this
+implementation. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Dict.h"
+#include "DictExt.h"
+#include "StrArena.h"
+#include "TopN.h"
+#include "WFreq.h"
+
+// an AVL tree of height 96 would need more than 2^64 nodes
+#define MAX_HEIGHT 96
+
+typedef struct Node *Node;
+struct Node {
+	char *data;
+	int word_count;
+	int height;          // a leaf has height 1
+	Node left;
+	Node right;
+};
+
+struct DictRep {
+	Node root;
+	StrArena arena;      // holds every node and word in the tree
+};
+
+// ************************ function prototypes ********************************
+static int height(Node n);
+static void update_height(Node n);
+static Node rotate_left(Node n);
+static Node rotate_right(Node n);
+static Node rebalance(Node n);
+static void visit_tree(Node n, DictVisitFn visit, void *ctx);
+static void tree_to_topn(Node n, TopN best);
+static void show_tree(Node n);
+// ************************ end of function prototypes *************************
+
+// Creates a new Dictionary
+Dict DictNew(void) {
+	Dict d = malloc(sizeof(struct DictRep));
+	assert(d != NULL);
+	d->root = NULL;
+	d->arena = StrArenaNew();
+	return d;
+}
+
+// Frees the given Dictionary
+void DictFree(Dict d) {
+	if (d == NULL) {
+		return;
+	}
+	StrArenaFree(d->arena);
+	free(d);
+}
+
+// Removes every word from the Dictionary
+void DictClear(Dict d) {
+	StrArenaReset(d->arena);
+	d->root = NULL;
+}
+
+// Inserts an occurrence of the given word into the Dictionary
+void DictInsert(Dict d, char *word) {
+	DictAdd(d, word, 1);
+}
+
+// Adds `count` occurrences of the given word to the Dictionary
+void DictAdd(Dict d, char *word, int count) {
+	// the links followed from the root down to where the word belongs
+	Node *path[MAX_HEIGHT];
+	int depth = 0;
+	Node *link = &d->root;
+	while (*link != NULL) {
+		int compare = strcmp(word, (*link)->data);
+		// if word is already in dictionary
+		if (compare == 0) {
+			(*link)->word_count += count;
+			return;
+		}
+		path[depth++] = link;
+		link = compare < 0 ? &(*link)->left : &(*link)->right;
+	}
+
+	Node new_node = StrArenaAlloc(d->arena, sizeof(struct Node));
+	new_node->data = StrArenaCopy(d->arena, word, strlen(word));
+	new_node->word_count = count;
+	new_node->height = 1;
+	new_node->left = NULL;
+	new_node->right = NULL;
+	*link = new_node;
+
+	// walk back up, rebalancing; once a subtree's height is unchanged,
+	// nothing above it can change either
+	while (depth > 0) {
+		Node *parent = path[--depth];
+		int old_height = (*parent)->height;
+		*parent = rebalance(*parent);
+		if ((*parent)->height == old_height) break;
+	}
+}
+
+// Returns the occurrence count of the given word. Returns 0 if the word
+// is not in the Dictionary.
+int DictFind(Dict d, char *word) {
+	Node n = d->root;
+	while (n != NULL) {
+		int compare = strcmp(word, n->data);
+		if (compare == 0) {
+			return n->word_count;
+		}
+		n = compare < 0 ? n->left : n->right;
+	}
+	return 0;
+}
+
+// Calls `visit` for every word in the Dictionary, in alphabetical order
+void DictForEach(Dict d, DictVisitFn visit, void *ctx) {
+	visit_tree(d->root, visit, ctx);
+}
+
+// Finds  the top `n` frequently occurring words in the given Dictionary
+// and stores them in the given  `wfs`  array  in  decreasing  order  of
+// frequency,  and then in increasing lexicographic order for words with
+// the same frequency. Returns the number of WFreq's stored in the given
+// array (this will be min(`n`, #words in the Dictionary)) in  case  the
+// Dictionary  does  not  contain enough words to fill the entire array.
+// Assumes that the `wfs` array has size `n`.
+int DictFindTopN(Dict d, WFreq *wfs, int n) {
+	// keep the best n words seen so far in a bounded heap
+	TopN best = TopNNew(n);
+	tree_to_topn(d->root, best);
+	int i = TopNFinish(best, wfs);
+	TopNFree(best);
+	return i;
+}
+
+// Displays the given Dictionary. This is purely for debugging purposes,
+// so  you  may  display the Dictionary in any format you want.  You may
+// choose not to implement this.
+void DictShow(Dict d) {
+	show_tree(d->root);
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+static int height(Node n) {
+	return n == NULL ? 0 : n->height;
+}
+
+static void update_height(Node n) {
+	int left = height(n->left);
+	int right = height(n->right);
+	n->height = (left > right ? left : right) + 1;
+}
+
+// makes n's right child the root of the subtree; n becomes its left child
+// and takes over its old left subtree
+static Node rotate_left(Node n) {
+	Node r = n->right;
+	n->right = r->left;
+	r->left = n;
+	update_height(n);
+	update_height(r);
+	return r;
+}
+
+// the mirror image of rotate_left
+static Node rotate_right(Node n) {
+	Node l = n->left;
+	n->left = l->right;
+	l->right = n;
+	update_height(n);
+	update_height(l);
+	return l;
+}
+
+// restores the AVL property at n, whose subtrees are AVL trees differing in
+// height by at most 2, and returns the new root of the subtree
+static Node rebalance(Node n) {
+	update_height(n);
+	int balance = height(n->left) - height(n->right);
+	if (balance > 1) {
+		// left-right case becomes left-left
+		if (height(n->left->left) < height(n->left->right)) {
+			n->left = rotate_left(n->left);
+		}
+		return rotate_right(n);
+	}
+	if (balance < -1) {
+		// right-left case becomes right-right
+		if (height(n->right->right) < height(n->right->left)) {
+			n->right = rotate_right(n->right);
+		}
+		return rotate_left(n);
+	}
+	return n;
+}
+
+// the traversals below recurse at most MAX_HEIGHT deep
+
+static void visit_tree(Node n, DictVisitFn visit, void *ctx) {
+	if (n == NULL) return;
+	visit_tree(n->left, visit, ctx);
+	visit(n->data, n->word_count, ctx);
+	visit_tree(n->right, visit, ctx);
+}
+
+// offers every node to the top-n selector
+static void tree_to_topn(Node n, TopN best) {
+	if (n == NULL) return;
+	tree_to_topn(n->left, best);
+	tree_to_topn(n->right, best);
+	TopNOffer(best, n->data, n->word_count);
+}
+
+static void show_tree(Node n) {
+	if (n == NULL) return;
+	show_tree(n->left);
+	printf("%s ", n->data);
+	show_tree(n->right);
+}
@@ -0,0 +1,28 @@
+// COMP2521 21T2 Assignment 1
+// DictExt.h ... extra Dictionary operations
+// z5361442 James Teng
+// Operations beyond Dict.h (which can't be changed) that are needed to
+// merge one Dictionary into another and to reuse one for several texts.
+// Both Dict.c and DictHash.c provide them.
+
+#ifndef DICTEXT_H
+#define DICTEXT_H
+
+#include "Dict.h"
+
+// Called once per word in a Dictionary. The word must not be modified and
+// is only valid until the Dictionary is next changed.
+typedef void (*DictVisitFn)(char *word, int count, void *ctx);
+
+// Adds `count` occurrences of the given word to the Dictionary, as if
+// DictInsert had been called `count` times
+void DictAdd(Dict d, char *word, int count);
+
+// Removes every word from the Dictionary, keeping whatever memory can be
+// reused for the next words
+void DictClear(Dict d);
+
+// Calls `visit` for every word in the Dictionary, in no particular order
+void DictForEach(Dict d, DictVisitFn visit, void *ctx);
+
+#endif
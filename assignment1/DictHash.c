@@ -0,0 +1,189 @@
+// COMP2521 21T2 Assignment 1
+// DictHash.c ... hash table implementation of the Dictionary ADT
+// z5361442 James Teng
+/* Alternative to Dict.c behind the same Dict.h interface. Words are kept in
+an open addressing table (linear probing) whose size is always a power of
+two, so a probe is a mask instead of a modulo. Every word is copied into a
+string arena and the slots only point at it, so the words returned by
+DictFindTopN stay valid however much the table grows afterwards. Link tw
+against DictHash.o instead of Dict.o to use this implementation. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Dict.h"
+#include "DictExt.h"
+#include "StrArena.h"
+#include "TopN.h"
+#include "WFreq.h"
+#include "WordHash.h"
+
+#define INITIAL_SLOTS 1024
+// grow once the table is 3/4 full
+#define MAX_LOAD_NUM 3
+#define MAX_LOAD_DEN 4
+
+struct Slot {
+	uint64_t hash;
+	int word_count;           // 0 marks an empty slot
+	int length;
+	char *word;               // in the arena
+};
+
+struct DictRep {
+	struct Slot *slots;
+	size_t capacity;          // always a power of two
+	size_t size;
+	StrArena arena;           // holds the words
+};
+
+// ************************ function prototypes ********************************
+static struct Slot *find_slot(Dict d, const char *word, size_t length, uint64_t hash);
+static void grow_table(Dict d);
+// ************************ end of function prototypes *************************
+
+// Creates a new Dictionary
+Dict DictNew(void) {
+	Dict d = malloc(sizeof(struct DictRep));
+	assert(d != NULL);
+	d->capacity = INITIAL_SLOTS;
+	d->size = 0;
+	d->slots = calloc(d->capacity, sizeof(struct Slot));
+	assert(d->slots != NULL);
+	d->arena = StrArenaNew();
+	return d;
+}
+
+// Frees the given Dictionary
+void DictFree(Dict d) {
+	StrArenaFree(d->arena);
+	free(d->slots);
+	free(d);
+}
+
+// Removes every word from the Dictionary, keeping the table at its
+// current size
+void DictClear(Dict d) {
+	StrArenaReset(d->arena);
+	memset(d->slots, 0, d->capacity * sizeof(struct Slot));
+	d->size = 0;
+}
+
+// Inserts an occurrence of the given word into the Dictionary
+void DictInsert(Dict d, char *word) {
+	DictAdd(d, word, 1);
+}
+
+// Adds `count` occurrences of the given word to the Dictionary
+void DictAdd(Dict d, char *word, int count) {
+	size_t length = strlen(word);
+	uint64_t hash = hash_word(word, length);
+	struct Slot *slot = find_slot(d, word, length, hash);
+	// if word is already in dictionary
+	if (slot->word_count > 0) {
+		slot->word_count += count;
+		return;
+	}
+
+	// grow first so the new word is placed in the final table
+	if ((d->size + 1) * MAX_LOAD_DEN > d->capacity * MAX_LOAD_NUM) {
+		grow_table(d);
+		slot = find_slot(d, word, length, hash);
+	}
+	slot->hash = hash;
+	slot->length = length;
+	slot->word_count = count;
+	slot->word = StrArenaCopy(d->arena, word, length);
+	d->size++;
+}
+
+// Returns the occurrence count of the given word. Returns 0 if the word
+// is not in the Dictionary.
+int DictFind(Dict d, char *word) {
+	size_t length = strlen(word);
+	struct Slot *slot = find_slot(d, word, length, hash_word(word, length));
+	return slot->word_count;
+}
+
+// Calls `visit` for every word in the Dictionary, in table order
+void DictForEach(Dict d, DictVisitFn visit, void *ctx) {
+	for (size_t i = 0; i < d->capacity; i++) {
+		if (d->slots[i].word_count > 0) {
+			visit(d->slots[i].word, d->slots[i].word_count, ctx);
+		}
+	}
+}
+
+// Finds  the top `n` frequently occurring words in the given Dictionary
+// and stores them in the given  `wfs`  array  in  decreasing  order  of
+// frequency,  and then in increasing lexicographic order for words with
+// the same frequency. Returns the number of WFreq's stored in the given
+// array (this will be min(`n`, #words in the Dictionary)) in  case  the
+// Dictionary  does  not  contain enough words to fill the entire array.
+// Assumes that the `wfs` array has size `n`.
+int DictFindTopN(Dict d, WFreq *wfs, int n) {
+	// keep the best n words seen so far in a bounded heap
+	TopN best = TopNNew(n);
+	for (size_t i = 0; i < d->capacity; i++) {
+		if (d->slots[i].word_count > 0) {
+			TopNOffer(best, d->slots[i].word, d->slots[i].word_count);
+		}
+	}
+	int i = TopNFinish(best, wfs);
+	TopNFree(best);
+	return i;
+}
+
+// Displays the given Dictionary. This is purely for debugging purposes,
+// so  you  may  display the Dictionary in any format you want.  You may
+// choose not to implement this.
+void DictShow(Dict d) {
+	// words are shown in table order, not alphabetically
+	for (size_t i = 0; i < d->capacity; i++) {
+		if (d->slots[i].word_count > 0) {
+			printf("%s ", d->slots[i].word);
+		}
+	}
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// returns the slot holding `word`, or the empty slot where it belongs
+static struct Slot *find_slot(Dict d, const char *word, size_t length, uint64_t hash) {
+	size_t mask = d->capacity - 1;
+	size_t i = hash & mask;
+	while (true) {
+		struct Slot *slot = &d->slots[i];
+		if (slot->word_count == 0) {
+			return slot;
+		}
+		if (slot->hash == hash && (size_t)slot->length == length &&
+		    memcmp(slot->word, word, length) == 0) {
+			return slot;
+		}
+		i = (i + 1) & mask;
+	}
+}
+
+// doubles the table, moving every slot to its place in the new table
+static void grow_table(Dict d) {
+	struct Slot *old_slots = d->slots;
+	size_t old_capacity = d->capacity;
+	d->capacity *= 2;
+	d->slots = calloc(d->capacity, sizeof(struct Slot));
+	assert(d->slots != NULL);
+	size_t mask = d->capacity - 1;
+	for (size_t i = 0; i < old_capacity; i++) {
+		if (old_slots[i].word_count == 0) continue;
+		size_t j = old_slots[i].hash & mask;
+		while (d->slots[j].word_count != 0) {
+			j = (j + 1) & mask;
+		}
+		d->slots[j] = old_slots[i];
+	}
+	free(old_slots);
+}
@@ -0,0 +1,238 @@
+// COMP2521 21T2 Assignment 1
+// HeavyHitters.c ... implementation of the streaming heavy hitters counter
+// z5361442 James Teng
+/* The counters are found by word through an open addressing table (linear
+probing, at most half full) and kept in a min-heap on count, so the word to
+replace is always at the root. Counting a tracked word only moves its
+counter down the heap; replacing a word removes it from the table with a
+backward shift, so the table never needs tombstones. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "HeavyHitters.h"
+#include "TopN.h"
+#include "WFreq.h"
+#include "WordHash.h"
+
+#define EMPTY -1
+
+struct Counter {
+	char *word;
+	size_t length;
+	size_t room;              // bytes allocated for word
+	uint64_t hash;
+	int count;                // estimated count
+	int error;                // most the count may be over by
+	int heap_pos;
+};
+
+struct HeavyHittersRep {
+	int capacity;
+	int used;
+	struct Counter *counters;
+	int *heap;                // counter indices, smallest count first
+	int *table;               // counter indices by word hash, or EMPTY
+	size_t table_size;        // always a power of two
+	long total;
+};
+
+// ************************ function prototypes ********************************
+static size_t find_slot(HeavyHitters hh, const char *word, size_t length,
+                        uint64_t hash);
+static void remove_slot(HeavyHitters hh, size_t slot);
+static void set_word(struct Counter *c, const char *word, size_t length,
+                     uint64_t hash);
+static bool heap_less(HeavyHitters hh, int a, int b);
+static void heap_swap(HeavyHitters hh, int i, int j);
+static void sift_up(HeavyHitters hh, int i);
+static void sift_down(HeavyHitters hh, int i);
+// ************************ end of function prototypes *************************
+
+HeavyHitters HeavyHittersNew(int capacity) {
+	assert(capacity > 0);
+	HeavyHitters hh = malloc(sizeof(struct HeavyHittersRep));
+	assert(hh != NULL);
+	hh->capacity = capacity;
+	hh->used = 0;
+	hh->total = 0;
+	hh->counters = calloc(capacity, sizeof(struct Counter));
+	hh->heap = malloc(capacity * sizeof(int));
+	hh->table_size = 1;
+	while (hh->table_size < 2 * (size_t)capacity) {
+		hh->table_size *= 2;
+	}
+	hh->table = malloc(hh->table_size * sizeof(int));
+	assert(hh->counters != NULL && hh->heap != NULL && hh->table != NULL);
+	for (size_t i = 0; i < hh->table_size; i++) {
+		hh->table[i] = EMPTY;
+	}
+	return hh;
+}
+
+void HeavyHittersFree(HeavyHitters hh) {
+	for (int i = 0; i < hh->used; i++) {
+		free(hh->counters[i].word);
+	}
+	free(hh->counters);
+	free(hh->heap);
+	free(hh->table);
+	free(hh);
+}
+
+void HeavyHittersInsert(HeavyHitters hh, char *word) {
+	hh->total++;
+	size_t length = strlen(word);
+	uint64_t hash = hash_word(word, length);
+	size_t slot = find_slot(hh, word, length, hash);
+	// if word is already tracked
+	if (hh->table[slot] != EMPTY) {
+		struct Counter *c = &hh->counters[hh->table[slot]];
+		c->count++;
+		sift_down(hh, c->heap_pos);
+		return;
+	}
+
+	int index;
+	if (hh->used < hh->capacity) {
+		// a free counter
+		index = hh->used++;
+		hh->counters[index].count = 0;
+		hh->counters[index].error = 0;
+		hh->counters[index].heap_pos = index;
+		hh->heap[index] = index;
+	}
+	else {
+		// take over the counter with the smallest count
+		index = hh->heap[0];
+		struct Counter *victim = &hh->counters[index];
+		remove_slot(hh, find_slot(hh, victim->word, victim->length, victim->hash));
+		victim->error = victim->count;
+		// the table may have shifted, so find the new word's slot again
+		slot = find_slot(hh, word, length, hash);
+	}
+	struct Counter *c = &hh->counters[index];
+	set_word(c, word, length, hash);
+	c->count++;
+	hh->table[slot] = index;
+	sift_up(hh, c->heap_pos);
+	sift_down(hh, c->heap_pos);
+}
+
+int HeavyHittersTopN(HeavyHitters hh, WFreq *wfs, int n) {
+	TopN best = TopNNew(n);
+	for (int i = 0; i < hh->used; i++) {
+		TopNOffer(best, hh->counters[i].word, hh->counters[i].count);
+	}
+	int stored = TopNFinish(best, wfs);
+	TopNFree(best);
+	return stored;
+}
+
+int HeavyHittersError(HeavyHitters hh, char *word) {
+	size_t length = strlen(word);
+	size_t slot = find_slot(hh, word, length, hash_word(word, length));
+	if (hh->table[slot] == EMPTY) {
+		return -1;
+	}
+	return hh->counters[hh->table[slot]].error;
+}
+
+long HeavyHittersTotal(HeavyHitters hh) {
+	return hh->total;
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// returns the slot holding `word`, or the empty slot where it belongs
+static size_t find_slot(HeavyHitters hh, const char *word, size_t length,
+                        uint64_t hash) {
+	size_t mask = hh->table_size - 1;
+	size_t i = hash & mask;
+	while (hh->table[i] != EMPTY) {
+		struct Counter *c = &hh->counters[hh->table[i]];
+		if (c->hash == hash && c->length == length &&
+		    memcmp(c->word, word, length) == 0) {
+			break;
+		}
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+// empties the slot, moving later entries of the same probe run back so
+// that every entry can still be reached from its home slot
+static void remove_slot(HeavyHitters hh, size_t slot) {
+	size_t mask = hh->table_size - 1;
+	size_t hole = slot;
+	size_t i = slot;
+	while (true) {
+		i = (i + 1) & mask;
+		if (hh->table[i] == EMPTY) break;
+		size_t home = hh->counters[hh->table[i]].hash & mask;
+		// the entry can move into the hole unless its home lies
+		// (cyclically) after the hole and at or before its slot
+		bool stays = hole <= i ? (hole < home && home <= i)
+		                       : (hole < home || home <= i);
+		if (!stays) {
+			hh->table[hole] = hh->table[i];
+			hole = i;
+		}
+	}
+	hh->table[hole] = EMPTY;
+}
+
+// stores a copy of the word in the counter, reusing its buffer if it fits
+static void set_word(struct Counter *c, const char *word, size_t length,
+                     uint64_t hash) {
+	if (c->room < length + 1) {
+		free(c->word);
+		c->room = length + 1;
+		c->word = malloc(c->room);
+		assert(c->word != NULL);
+	}
+	memcpy(c->word, word, length + 1);
+	c->length = length;
+	c->hash = hash;
+}
+
+// orders heap slots by count, then by counter so ties are reproducible
+static bool heap_less(HeavyHitters hh, int a, int b) {
+	struct Counter *c_a = &hh->counters[hh->heap[a]];
+	struct Counter *c_b = &hh->counters[hh->heap[b]];
+	if (c_a->count != c_b->count) {
+		return c_a->count < c_b->count;
+	}
+	return hh->heap[a] < hh->heap[b];
+}
+
+static void heap_swap(HeavyHitters hh, int i, int j) {
+	int temp = hh->heap[i];
+	hh->heap[i] = hh->heap[j];
+	hh->heap[j] = temp;
+	hh->counters[hh->heap[i]].heap_pos = i;
+	hh->counters[hh->heap[j]].heap_pos = j;
+}
+
+static void sift_up(HeavyHitters hh, int i) {
+	while (i > 0 && heap_less(hh, i, (i - 1) / 2)) {
+		heap_swap(hh, i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+}
+
+static void sift_down(HeavyHitters hh, int i) {
+	while (2 * i + 1 < hh->used) {
+		int child = 2 * i + 1;
+		if (child + 1 < hh->used && heap_less(hh, child + 1, child)) {
+			child++;
+		}
+		if (!heap_less(hh, child, i)) break;
+		heap_swap(hh, i, child);
+		i = child;
+	}
+}
@@ -0,0 +1,41 @@
+// COMP2521 21T2 Assignment 1
+// HeavyHitters.h ... interface to the streaming heavy hitters counter
+// z5361442 James Teng
+// Approximate word counts in fixed memory (the Space-Saving algorithm).
+// Only `capacity` words are tracked at a time; when a new word arrives and
+// every counter is taken, the word with the smallest count is replaced and
+// the new word inherits that count as its possible error. So each count is
+// an overestimate by at most its error, the error is at most
+// (words seen) / capacity, and every word seen more often than that is
+// guaranteed to be tracked. The top words can be read at any time.
+
+#ifndef HEAVYHITTERS_H
+#define HEAVYHITTERS_H
+
+#include "WFreq.h"
+
+typedef struct HeavyHittersRep *HeavyHitters;
+
+// Creates a counter that tracks at most `capacity` words
+HeavyHitters HeavyHittersNew(int capacity);
+
+// Frees the given counter
+void HeavyHittersFree(HeavyHitters hh);
+
+// Counts an occurrence of the given word
+void HeavyHittersInsert(HeavyHitters hh, char *word);
+
+// Stores the (at most `n`) tracked words with the highest estimated counts
+// in `wfs`, in DictFindTopN order, and returns how many were stored. The
+// words stay valid until the next HeavyHittersInsert. Does not change the
+// counter, so it can be called at any time.
+int HeavyHittersTopN(HeavyHitters hh, WFreq *wfs, int n);
+
+// Returns the most the estimated count of the given word may exceed its
+// true count by, or -1 if the word is not tracked
+int HeavyHittersError(HeavyHitters hh, char *word);
+
+// Returns the number of words counted so far
+long HeavyHittersTotal(HeavyHitters hh);
+
+#endif
@@ -0,0 +1,134 @@
+// COMP2521 21T2 Assignment 1
+// StemCache.c ... implementation of the stemming cache
+// z5361442 James Teng
+/* The cache is an open addressing table split into sets of WAYS entries: a
+word can only live in the set its hash picks, so a lookup checks at most
+WAYS entries, and each entry is one 64 byte cache line. Every entry has a
+"referenced" bit that is set when it is used. To make room, the set's
+clock hand sweeps round the set, clearing referenced bits, and evicts the
+first entry whose bit is already clear. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StemCache.h"
+#include "stemmer.h"
+#include "WordHash.h"
+
+#define WAYS 8
+// longest word that is cached; a stem is never longer than its word
+#define MAX_CACHED 26
+
+struct Entry {
+	uint64_t hash;
+	uint8_t length;           // 0 marks an empty entry
+	uint8_t stem_length;
+	uint8_t referenced;
+	char word[MAX_CACHED];
+	char stem[MAX_CACHED];
+};
+
+struct StemCacheRep {
+	struct Entry *entries;
+	uint8_t *hand;            // clock hand of each set
+	size_t sets;              // always a power of two
+	StemCacheStats stats;
+};
+
+// ************************ function prototypes ********************************
+static struct Entry *choose_victim(StemCache c, size_t set);
+// ************************ end of function prototypes *************************
+
+StemCache StemCacheNew(int entries) {
+	StemCache c = malloc(sizeof(struct StemCacheRep));
+	assert(c != NULL);
+	c->sets = 1;
+	while (c->sets * WAYS < (size_t)entries) {
+		c->sets *= 2;
+	}
+	c->entries = calloc(c->sets * WAYS, sizeof(struct Entry));
+	c->hand = calloc(c->sets, sizeof(uint8_t));
+	assert(c->entries != NULL && c->hand != NULL);
+	memset(&c->stats, 0, sizeof(c->stats));
+	return c;
+}
+
+void StemCacheFree(StemCache c) {
+	free(c->entries);
+	free(c->hand);
+	free(c);
+}
+
+void StemCacheStem(StemCache c, char *word, size_t length) {
+	c->stats.lookups++;
+	if (length > MAX_CACHED) {
+		c->stats.bypassed++;
+		stem(word, 0, length - 1);
+		return;
+	}
+
+	uint64_t hash = hash_word(word, length);
+	size_t set = hash & (c->sets - 1);
+	struct Entry *ways = &c->entries[set * WAYS];
+	for (int i = 0; i < WAYS; i++) {
+		struct Entry *entry = &ways[i];
+		if (entry->hash == hash && entry->length == length &&
+		    memcmp(entry->word, word, length) == 0) {
+			c->stats.hits++;
+			entry->referenced = 1;
+			memcpy(word, entry->stem, entry->stem_length);
+			word[entry->stem_length] = '\0';
+			return;
+		}
+	}
+
+	// miss - remember the word before the stemmer overwrites it
+	struct Entry *entry = choose_victim(c, set);
+	entry->hash = hash;
+	entry->length = length;
+	entry->referenced = 1;
+	memcpy(entry->word, word, length);
+	stem(word, 0, length - 1);
+	// cache what the caller will see, up to the NUL the stemmer leaves
+	entry->stem_length = strlen(word);
+	memcpy(entry->stem, word, entry->stem_length);
+}
+
+StemCacheStats StemCacheGetStats(StemCache c) {
+	return c->stats;
+}
+
+void StemCacheShowStats(StemCache c, FILE *out) {
+	StemCacheStats s = c->stats;
+	long cacheable = s.lookups - s.bypassed;
+	fprintf(out, "stem cache: %zu entries, %ld lookups, %ld hits (%.1f%%), "
+	        "%ld bypassed, %ld evictions\n", c->sets * WAYS, s.lookups, s.hits,
+	        cacheable > 0 ? 100.0 * s.hits / cacheable : 0.0, s.bypassed,
+	        s.evictions);
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// returns an empty entry of the set if there is one, otherwise evicts one
+// that has not been referenced since the clock hand last passed it
+static struct Entry *choose_victim(StemCache c, size_t set) {
+	struct Entry *ways = &c->entries[set * WAYS];
+	for (int i = 0; i < WAYS; i++) {
+		if (ways[i].length == 0) {
+			return &ways[i];
+		}
+	}
+	c->stats.evictions++;
+	while (true) {
+		struct Entry *entry = &ways[c->hand[set]];
+		c->hand[set] = (c->hand[set] + 1) % WAYS;
+		if (!entry->referenced) {
+			return entry;
+		}
+		entry->referenced = 0;
+	}
+}
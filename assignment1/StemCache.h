@@ -0,0 +1,40 @@
+// COMP2521 21T2 Assignment 1
+// StemCache.h ... interface to the stemming cache
+// z5361442 James Teng
+// Remembers the stems of recently seen words, so a word that keeps coming
+// up is only run through the stemmer once. The cache has a fixed number of
+// entries; when it is full, words that have not been used lately are
+// evicted (CLOCK). Not safe to share between threads.
+
+#ifndef STEMCACHE_H
+#define STEMCACHE_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+typedef struct StemCacheRep *StemCache;
+
+typedef struct StemCacheStats {
+	long lookups;     // words stemmed through the cache
+	long hits;        // stems found in the cache
+	long bypassed;    // words too long to cache (always stemmed)
+	long evictions;   // entries replaced to make room
+} StemCacheStats;
+
+// Creates a cache with room for about `entries` words
+StemCache StemCacheNew(int entries);
+
+// Frees the given cache
+void StemCacheFree(StemCache c);
+
+// Stems the `length` byte, NUL-terminated word in place, exactly as
+// stem(word, 0, length - 1) would
+void StemCacheStem(StemCache c, char *word, size_t length);
+
+// Returns the statistics gathered since the cache was created
+StemCacheStats StemCacheGetStats(StemCache c);
+
+// Prints the statistics, including the hit rate, to the given stream
+void StemCacheShowStats(StemCache c, FILE *out);
+
+#endif
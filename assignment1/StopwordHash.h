@@ -0,0 +1,37 @@
+// COMP2521 21T2 Assignment 1
+// StopwordHash.h ... hash functions shared by Stopwords.c and mkstopwords.c
+// z5361442 James Teng
+// The perfect hash table generated by mkstopwords is only valid if lookups
+// hash words exactly the way the generator did, so both include this file.
+// Words are hashed with hash_word_seeded from WordHash.h.
+
+#ifndef STOPWORDHASH_H
+#define STOPWORDHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "WordHash.h"
+
+// derives the second hash used to place a word within its bucket, without
+// hashing the word's bytes again
+static inline uint64_t stopword_rehash(uint64_t hash) {
+	hash ^= hash >> 31;
+	hash *= 0xBF58476D1CE4E5B9ULL;
+	hash ^= hash >> 27;
+	return hash;
+}
+
+// slot of a word in the perfect hash table (CHD "hash and displace"): the
+// word's bucket holds a displacement pair (d0, d1), packed as d0 * size + d1,
+// and the slot is f1 + d0 * f2 + d1
+static inline size_t stopword_slot(uint64_t hash, uint32_t displacement, size_t size) {
+	uint64_t rehash = stopword_rehash(hash);
+	uint64_t f1 = (uint32_t)rehash % size;
+	uint64_t f2 = (rehash >> 32) % size;
+	uint64_t d0 = displacement / size;
+	uint64_t d1 = displacement % size;
+	return (size_t)((f1 + d0 * f2 + d1) % size);
+}
+
+#endif
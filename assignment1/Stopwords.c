@@ -0,0 +1,175 @@
+// COMP2521 21T2 Assignment 1
+// Stopwords.c ... implementation of the stopword set
+// z5361442 James Teng
+/* A loaded set is an open addressing table (linear probing) kept at most
+half full, so a lookup is one hash and usually one compare. The builtin set
+is the minimal perfect hash table in StopwordsTable.h, generated with
+	./mkstopwords stopwords > StopwordsTable.h
+where every word has exactly one possible slot, so a lookup is always one
+hash and one compare. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BookText.h"
+#include "StopwordHash.h"
+#include "Stopwords.h"
+
+#ifdef STOPWORDS_BUILTIN
+#include "StopwordsTable.h"
+#endif
+
+#define INITIAL_SLOTS 1024
+
+struct Slot {
+	uint64_t hash;
+	char *word;               // NULL marks an empty slot
+	size_t length;
+};
+
+struct StopwordsRep {
+	bool builtin;
+	struct Slot *slots;
+	size_t capacity;          // always a power of two
+	size_t size;
+};
+
+// ************************ function prototypes ********************************
+static void add_word(Stopwords sw, const char *word, size_t length);
+static struct Slot *find_slot(Stopwords sw, const char *word, size_t length,
+                              uint64_t hash);
+static void grow_table(Stopwords sw);
+static bool builtin_contains(const char *word, size_t length);
+// ************************ end of function prototypes *************************
+
+Stopwords StopwordsBuiltin(void) {
+#ifdef STOPWORDS_BUILTIN
+	static struct StopwordsRep builtin = {.builtin = true};
+	return &builtin;
+#else
+	return NULL;
+#endif
+}
+
+Stopwords StopwordsLoad(char *fileName) {
+	BookText file;
+	if (!BookTextOpen(fileName, &file)) {
+		return NULL;
+	}
+	Stopwords sw = malloc(sizeof(struct StopwordsRep));
+	assert(sw != NULL);
+	sw->builtin = false;
+	sw->capacity = INITIAL_SLOTS;
+	sw->size = 0;
+	sw->slots = calloc(sw->capacity, sizeof(struct Slot));
+	assert(sw->slots != NULL);
+
+	// one word per line; the last line need not end in a newline
+	const char *line = file.data;
+	const char *end = file.data + file.length;
+	while (line < end) {
+		const char *newline = memchr(line, '\n', end - line);
+		const char *line_end = newline != NULL ? newline : end;
+		if (line_end > line) {
+			add_word(sw, line, line_end - line);
+		}
+		line = line_end + 1;
+	}
+	BookTextClose(&file);
+	return sw;
+}
+
+void StopwordsFree(Stopwords sw) {
+	if (sw == NULL || sw->builtin) return;
+	for (size_t i = 0; i < sw->capacity; i++) {
+		free(sw->slots[i].word);
+	}
+	free(sw->slots);
+	free(sw);
+}
+
+bool StopwordsContains(Stopwords sw, const char *word, size_t length) {
+	if (sw->builtin) {
+		return builtin_contains(word, length);
+	}
+	struct Slot *slot = find_slot(sw, word, length, hash_word(word, length));
+	return slot->word != NULL;
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// adds a copy of the word to a loaded set, ignoring duplicates
+static void add_word(Stopwords sw, const char *word, size_t length) {
+	uint64_t hash = hash_word(word, length);
+	struct Slot *slot = find_slot(sw, word, length, hash);
+	if (slot->word != NULL) return;
+
+	// grow first so the new word is placed in the final table
+	if ((sw->size + 1) * 2 > sw->capacity) {
+		grow_table(sw);
+		slot = find_slot(sw, word, length, hash);
+	}
+	slot->hash = hash;
+	slot->length = length;
+	slot->word = malloc(length + 1);
+	assert(slot->word != NULL);
+	memcpy(slot->word, word, length);
+	slot->word[length] = '\0';
+	sw->size++;
+}
+
+// returns the slot holding `word`, or the empty slot where it belongs
+static struct Slot *find_slot(Stopwords sw, const char *word, size_t length,
+                              uint64_t hash) {
+	size_t mask = sw->capacity - 1;
+	size_t i = hash & mask;
+	while (true) {
+		struct Slot *slot = &sw->slots[i];
+		if (slot->word == NULL) {
+			return slot;
+		}
+		if (slot->hash == hash && slot->length == length &&
+		    memcmp(slot->word, word, length) == 0) {
+			return slot;
+		}
+		i = (i + 1) & mask;
+	}
+}
+
+// doubles the table, moving every slot to its place in the new table
+static void grow_table(Stopwords sw) {
+	struct Slot *old_slots = sw->slots;
+	size_t old_capacity = sw->capacity;
+	sw->capacity *= 2;
+	sw->slots = calloc(sw->capacity, sizeof(struct Slot));
+	assert(sw->slots != NULL);
+	size_t mask = sw->capacity - 1;
+	for (size_t i = 0; i < old_capacity; i++) {
+		if (old_slots[i].word == NULL) continue;
+		size_t j = old_slots[i].hash & mask;
+		while (sw->slots[j].word != NULL) {
+			j = (j + 1) & mask;
+		}
+		sw->slots[j] = old_slots[i];
+	}
+	free(old_slots);
+}
+
+// looks the word up in the generated perfect hash table
+static bool builtin_contains(const char *word, size_t length) {
+#ifdef STOPWORDS_BUILTIN
+	uint64_t hash = hash_word_seeded(word, length, STOPWORDS_SEED);
+	uint32_t displacement = stopword_displacement[hash % STOPWORDS_BUCKETS];
+	size_t slot = stopword_slot(hash, displacement, STOPWORDS_SIZE);
+	return stopword_length[slot] == length &&
+	       memcmp(stopword_word[slot], word, length) == 0;
+#else
+	(void)word;
+	(void)length;
+	return false;
+#endif
+}
@@ -0,0 +1,31 @@
+// COMP2521 21T2 Assignment 1
+// Stopwords.h ... interface to the stopword set
+// z5361442 James Teng
+// A set of words to be ignored when counting. The set either comes from a
+// file read at runtime (any number of words, one per line) or, in builds
+// with -DSTOPWORDS_BUILTIN, from a perfect hash table generated from the
+// stopwords file by mkstopwords, which needs no file at startup.
+
+#ifndef STOPWORDS_H
+#define STOPWORDS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct StopwordsRep *Stopwords;
+
+// Returns the set compiled into the program, or NULL if it was built
+// without -DSTOPWORDS_BUILTIN
+Stopwords StopwordsBuiltin(void);
+
+// Reads a set from the named file, one word per line. Returns NULL if the
+// file can't be opened.
+Stopwords StopwordsLoad(char *fileName);
+
+// Frees the given set (does nothing for the builtin set)
+void StopwordsFree(Stopwords sw);
+
+// Returns true if the `length` byte word is in the set
+bool StopwordsContains(Stopwords sw, const char *word, size_t length);
+
+#endif
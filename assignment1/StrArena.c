@@ -0,0 +1,103 @@
+// COMP2521 21T2 Assignment 1
+// StrArena.c ... implementation of the string arena
+// z5361442 James Teng
+/* Chunks are kept in a singly linked list, newest first; only the newest
+chunk is allocated from. Strings are packed with no padding, and only
+StrArenaAlloc aligns its result. An object bigger than a chunk gets a
+chunk of its own. */
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StrArena.h"
+
+#define CHUNK_SIZE 65536
+
+struct Chunk {
+	struct Chunk *next;
+	size_t size;              // bytes usable in `bytes`
+	alignas(max_align_t) char bytes[];
+};
+
+struct StrArenaRep {
+	struct Chunk *chunks;     // newest chunk first
+	size_t used;              // bytes used in the newest chunk
+};
+
+// ************************ function prototypes ********************************
+static char *bump(StrArena a, size_t size, size_t align);
+static void add_chunk(StrArena a, size_t size);
+// ************************ end of function prototypes *************************
+
+StrArena StrArenaNew(void) {
+	StrArena a = malloc(sizeof(struct StrArenaRep));
+	assert(a != NULL);
+	a->chunks = NULL;
+	a->used = 0;
+	return a;
+}
+
+void StrArenaFree(StrArena a) {
+	struct Chunk *chunk = a->chunks;
+	while (chunk != NULL) {
+		struct Chunk *next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	free(a);
+}
+
+void StrArenaReset(StrArena a) {
+	if (a->chunks == NULL) return;
+	// keep the oldest chunk, which is always a standard one
+	struct Chunk *chunk = a->chunks;
+	while (chunk->next != NULL) {
+		struct Chunk *next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	a->chunks = chunk;
+	a->used = 0;
+}
+
+void *StrArenaAlloc(StrArena a, size_t size) {
+	return bump(a, size, alignof(max_align_t));
+}
+
+char *StrArenaCopy(StrArena a, const char *s, size_t length) {
+	char *copy = bump(a, length + 1, 1);
+	memcpy(copy, s, length);
+	copy[length] = '\0';
+	return copy;
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// returns the next `size` bytes of the newest chunk, starting a new chunk
+// if they don't fit
+static char *bump(StrArena a, size_t size, size_t align) {
+	size_t start = (a->used + align - 1) & ~(align - 1);
+	if (a->chunks == NULL || start + size > a->chunks->size) {
+		add_chunk(a, size);
+		start = 0;
+	}
+	a->used = start + size;
+	return a->chunks->bytes + start;
+}
+
+// starts a new chunk with room for at least `size` bytes
+static void add_chunk(StrArena a, size_t size) {
+	size_t chunk_size = size > CHUNK_SIZE ? size : CHUNK_SIZE;
+	// the first chunk must be a standard one so StrArenaReset can keep it
+	if (a->chunks == NULL && chunk_size > CHUNK_SIZE) {
+		add_chunk(a, CHUNK_SIZE);
+	}
+	struct Chunk *chunk = malloc(sizeof(struct Chunk) + chunk_size);
+	assert(chunk != NULL);
+	chunk->next = a->chunks;
+	chunk->size = chunk_size;
+	a->chunks = chunk;
+}
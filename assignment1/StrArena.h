@@ -0,0 +1,33 @@
+// COMP2521 21T2 Assignment 1
+// StrArena.h ... interface to the string arena
+// z5361442 James Teng
+// A bump allocator for many small objects (mostly strings) that all live
+// until the arena is reset or freed. Memory is taken from the system in
+// large chunks that never move, so pointers into the arena stay valid
+// until StrArenaReset or StrArenaFree, and freeing everything costs one
+// free per chunk instead of one per object.
+
+#ifndef STRARENA_H
+#define STRARENA_H
+
+#include <stddef.h>
+
+typedef struct StrArenaRep *StrArena;
+
+// Creates an empty arena
+StrArena StrArenaNew(void);
+
+// Frees the arena and everything allocated from it
+void StrArenaFree(StrArena a);
+
+// Releases everything allocated from the arena, keeping one chunk to be
+// reused by the next allocations
+void StrArenaReset(StrArena a);
+
+// Returns `size` bytes aligned for any type
+void *StrArenaAlloc(StrArena a, size_t size);
+
+// Returns a NUL-terminated copy of the first `length` bytes of `s`
+char *StrArenaCopy(StrArena a, const char *s, size_t length);
+
+#endif
@@ -0,0 +1,200 @@
+// COMP2521 21T2 Assignment 1
+// Tokeniser.c ... implementation of the word tokeniser
+// z5361442 James Teng
+/* The text is processed in blocks that end on a word boundary. One pass
+over a block classifies every byte, writes the lower-cased byte (or '\0'
+for a separator) to an output buffer and sets a bit per word byte in a
+bitmap. Words are then read off the bitmap with count-trailing-zeros, so
+separators are never looked at a second time, and every word in the
+output buffer is already NUL-terminated by the separator after it.
+
+The vector and scalar classifiers agree byte for byte: bytes >= 0x80 are
+never word characters, matching isalnum in the C locale. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(TOKENISER_SCALAR) && defined(__AVX2__)
+#include <immintrin.h>
+#define VECTOR_WIDTH 32
+#elif !defined(TOKENISER_SCALAR) && defined(__SSE2__)
+#include <emmintrin.h>
+#define VECTOR_WIDTH 16
+#else
+#define VECTOR_WIDTH 0
+#endif
+
+#include "Tokeniser.h"
+
+#define BLOCK 65536
+
+struct Scratch {
+	size_t capacity;   // bytes the buffers can hold
+	char *lower;       // lower-cased block, '\0' at separators
+	uint64_t *bits;    // one bit per byte, set for word characters
+};
+
+// ************************ function prototypes ********************************
+static bool is_word_char(unsigned char c);
+static void scratch_reserve(struct Scratch *s, size_t length);
+static void classify(const char *text, size_t length, struct Scratch *s);
+static void emit_words(struct Scratch *s, size_t length, TokenFn emit, void *ctx);
+static size_t next_bit(const uint64_t *bits, size_t from, size_t length, bool set);
+// ************************ end of function prototypes *************************
+
+void TokeniseText(const char *begin, const char *end, TokenFn emit, void *ctx) {
+	struct Scratch s = {0};
+	const char *curr = begin;
+	while (curr < end) {
+		// cut the block just before a word that straddles the block end;
+		// if the whole block is one word, extend it to the end of the word
+		const char *cut = end - curr > BLOCK ? curr + BLOCK : end;
+		if (cut < end && is_word_char(*cut)) {
+			const char *back = cut;
+			while (back > curr && is_word_char(back[-1])) {
+				back--;
+			}
+			if (back > curr) {
+				cut = back;
+			}
+			else {
+				while (cut < end && is_word_char(*cut)) {
+					cut++;
+				}
+			}
+		}
+		size_t length = cut - curr;
+		scratch_reserve(&s, length);
+		classify(curr, length, &s);
+		emit_words(&s, length, emit, ctx);
+		curr = cut;
+	}
+	free(s.lower);
+	free(s.bits);
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+static bool is_word_char(unsigned char c) {
+	return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') ||
+	       (c >= 'a' && c <= 'z') || c == '\'' || c == '-';
+}
+
+static void scratch_reserve(struct Scratch *s, size_t length) {
+	if (length < s->capacity) return;
+	// one extra byte so the last word is always NUL-terminated, and whole
+	// bitmap words so the bit scan never reads past the end
+	s->capacity = length + 1;
+	s->lower = realloc(s->lower, s->capacity);
+	s->bits = realloc(s->bits, (s->capacity / 64 + 1) * sizeof(uint64_t));
+	assert(s->lower != NULL && s->bits != NULL);
+}
+
+// fills the lower-cased buffer and word bitmap for `length` bytes of text
+static void classify(const char *text, size_t length, struct Scratch *s) {
+	memset(s->bits, 0, (length / 64 + 1) * sizeof(uint64_t));
+	size_t i = 0;
+
+#if VECTOR_WIDTH == 32
+	const __m256i below_0 = _mm256_set1_epi8('0' - 1);
+	const __m256i above_9 = _mm256_set1_epi8('9' + 1);
+	const __m256i below_A = _mm256_set1_epi8('A' - 1);
+	const __m256i above_Z = _mm256_set1_epi8('Z' + 1);
+	const __m256i below_a = _mm256_set1_epi8('a' - 1);
+	const __m256i above_z = _mm256_set1_epi8('z' + 1);
+	const __m256i apostrophe = _mm256_set1_epi8('\'');
+	const __m256i hyphen = _mm256_set1_epi8('-');
+	const __m256i case_bit = _mm256_set1_epi8(0x20);
+	for (; i + 32 <= length; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *)(text + i));
+		// signed compares, so bytes >= 0x80 fall outside every range
+		__m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(x, below_0),
+		                                 _mm256_cmpgt_epi8(above_9, x));
+		__m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(x, below_A),
+		                                 _mm256_cmpgt_epi8(above_Z, x));
+		__m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(x, below_a),
+		                                 _mm256_cmpgt_epi8(above_z, x));
+		__m256i word = _mm256_or_si256(_mm256_or_si256(digit, upper), lower);
+		word = _mm256_or_si256(word, _mm256_cmpeq_epi8(x, apostrophe));
+		word = _mm256_or_si256(word, _mm256_cmpeq_epi8(x, hyphen));
+		__m256i folded = _mm256_or_si256(x, _mm256_and_si256(upper, case_bit));
+		_mm256_storeu_si256((__m256i *)(s->lower + i), _mm256_and_si256(folded, word));
+		uint64_t mask = (uint32_t)_mm256_movemask_epi8(word);
+		s->bits[i / 64] |= mask << (i % 64);
+	}
+#elif VECTOR_WIDTH == 16
+	const __m128i below_0 = _mm_set1_epi8('0' - 1);
+	const __m128i above_9 = _mm_set1_epi8('9' + 1);
+	const __m128i below_A = _mm_set1_epi8('A' - 1);
+	const __m128i above_Z = _mm_set1_epi8('Z' + 1);
+	const __m128i below_a = _mm_set1_epi8('a' - 1);
+	const __m128i above_z = _mm_set1_epi8('z' + 1);
+	const __m128i apostrophe = _mm_set1_epi8('\'');
+	const __m128i hyphen = _mm_set1_epi8('-');
+	const __m128i case_bit = _mm_set1_epi8(0x20);
+	for (; i + 16 <= length; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(text + i));
+		// signed compares, so bytes >= 0x80 fall outside every range
+		__m128i digit = _mm_and_si128(_mm_cmpgt_epi8(x, below_0),
+		                              _mm_cmplt_epi8(x, above_9));
+		__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(x, below_A),
+		                              _mm_cmplt_epi8(x, above_Z));
+		__m128i lower = _mm_and_si128(_mm_cmpgt_epi8(x, below_a),
+		                              _mm_cmplt_epi8(x, above_z));
+		__m128i word = _mm_or_si128(_mm_or_si128(digit, upper), lower);
+		word = _mm_or_si128(word, _mm_cmpeq_epi8(x, apostrophe));
+		word = _mm_or_si128(word, _mm_cmpeq_epi8(x, hyphen));
+		__m128i folded = _mm_or_si128(x, _mm_and_si128(upper, case_bit));
+		_mm_storeu_si128((__m128i *)(s->lower + i), _mm_and_si128(folded, word));
+		uint64_t mask = (uint32_t)_mm_movemask_epi8(word);
+		s->bits[i / 64] |= mask << (i % 64);
+	}
+#endif
+
+	// scalar path for whatever the vector loop did not cover
+	for (; i < length; i++) {
+		unsigned char c = text[i];
+		if (is_word_char(c)) {
+			s->lower[i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+			s->bits[i / 64] |= (uint64_t)1 << (i % 64);
+		}
+		else {
+			s->lower[i] = '\0';
+		}
+	}
+	s->lower[length] = '\0';
+}
+
+// reads the runs of set bits out of the bitmap and emits them as words
+static void emit_words(struct Scratch *s, size_t length, TokenFn emit, void *ctx) {
+	size_t pos = 0;
+	while (pos < length) {
+		size_t start = next_bit(s->bits, pos, length, true);
+		if (start >= length) break;
+		size_t stop = next_bit(s->bits, start, length, false);
+		emit(s->lower + start, stop - start, ctx);
+		pos = stop;
+	}
+}
+
+// returns the first position at or after `from` whose bit equals `set`,
+// or `length` if there is none
+static size_t next_bit(const uint64_t *bits, size_t from, size_t length, bool set) {
+	size_t word = from / 64;
+	uint64_t current = set ? bits[word] : ~bits[word];
+	// ignore the bits before `from`
+	current &= ~(uint64_t)0 << (from % 64);
+	while (current == 0) {
+		word++;
+		if (word * 64 >= length) {
+			return length;
+		}
+		current = set ? bits[word] : ~bits[word];
+	}
+	size_t pos = word * 64 + __builtin_ctzll(current);
+	return pos < length ? pos : length;
+}
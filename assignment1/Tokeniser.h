@@ -0,0 +1,21 @@
+// COMP2521 21T2 Assignment 1
+// Tokeniser.h ... interface to the word tokeniser
+// z5361442 James Teng
+// Splits text into words: maximal runs of word characters (ASCII letters
+// and digits, '\'' and '-'), lower-cased. Everything else separates words.
+
+#ifndef TOKENISER_H
+#define TOKENISER_H
+
+#include <stddef.h>
+
+// Called once per word. `token` is lower-cased, NUL-terminated and may be
+// modified in place (e.g. by the stemmer); it is only valid during the call.
+typedef void (*TokenFn)(char *token, size_t length, void *ctx);
+
+// Calls `emit` for every word in the text between `begin` and `end`, in
+// order. Uses AVX2 or SSE2 when the build targets them (define
+// TOKENISER_SCALAR to force the portable version).
+void TokeniseText(const char *begin, const char *end, TokenFn emit, void *ctx);
+
+#endif
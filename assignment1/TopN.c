@@ -0,0 +1,119 @@
+// COMP2521 21T2 Assignment 1
+// TopN.c ... implementation of the top-N word selector
+// z5361442 James Teng
+/* The heap is a min-heap on the DictFindTopN order, so its root is the
+worst pair kept so far. A new pair either replaces the root or is
+dropped. The heap array grows on demand up to `n` entries, so asking for a
+large `n` over a small vocabulary costs nothing extra. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TopN.h"
+#include "WFreq.h"
+
+#define INITIAL_HEAP 64
+
+struct TopNRep {
+	int n;          // number of pairs to keep
+	int size;       // number of pairs kept so far
+	int capacity;   // allocated size of heap (at most n)
+	WFreq *heap;
+};
+
+// ************************ function prototypes ********************************
+static bool worse(WFreq *a, WFreq *b);
+static void sift_up(TopN t, int i);
+static void sift_down(TopN t, int i);
+// ************************ end of function prototypes *************************
+
+TopN TopNNew(int n) {
+	TopN t = malloc(sizeof(struct TopNRep));
+	assert(t != NULL);
+	t->n = n > 0 ? n : 0;
+	t->size = 0;
+	t->capacity = t->n < INITIAL_HEAP ? t->n : INITIAL_HEAP;
+	t->heap = malloc((t->capacity > 0 ? t->capacity : 1) * sizeof(WFreq));
+	assert(t->heap != NULL);
+	return t;
+}
+
+void TopNFree(TopN t) {
+	free(t->heap);
+	free(t);
+}
+
+void TopNOffer(TopN t, char *word, int freq) {
+	WFreq pair = {.word = word, .freq = freq};
+	if (t->size < t->n) {
+		if (t->size == t->capacity) {
+			t->capacity = t->capacity * 2 < t->n ? t->capacity * 2 : t->n;
+			t->heap = realloc(t->heap, t->capacity * sizeof(WFreq));
+			assert(t->heap != NULL);
+		}
+		t->heap[t->size] = pair;
+		t->size++;
+		sift_up(t, t->size - 1);
+	}
+	// replace the worst kept pair if the new one beats it
+	else if (t->n > 0 && worse(&t->heap[0], &pair)) {
+		t->heap[0] = pair;
+		sift_down(t, 0);
+	}
+}
+
+int TopNFinish(TopN t, WFreq *wfs) {
+	int count = t->size;
+	memcpy(wfs, t->heap, count * sizeof(WFreq));
+	qsort(wfs, count, sizeof(WFreq), order_sorter);
+	t->size = 0;
+	return count;
+}
+
+// compare function for qsort
+// determines the order to sort the array: higher frequency first, then
+// lexicographically smaller words first
+int order_sorter(const void *object_1, const void *object_2) {
+	const WFreq *node_1 = object_1;
+	const WFreq *node_2 = object_2;
+	if (node_1->freq > node_2->freq) {
+		return -1;
+	}
+	else if (node_1->freq < node_2->freq) {
+		return 1;
+	}
+	return strcmp(node_1->word, node_2->word);
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// returns true if `a` comes after `b` in the DictFindTopN order
+static bool worse(WFreq *a, WFreq *b) {
+	return order_sorter(a, b) > 0;
+}
+
+static void sift_up(TopN t, int i) {
+	while (i > 0 && worse(&t->heap[i], &t->heap[(i - 1) / 2])) {
+		WFreq temp = t->heap[i];
+		t->heap[i] = t->heap[(i - 1) / 2];
+		t->heap[(i - 1) / 2] = temp;
+		i = (i - 1) / 2;
+	}
+}
+
+static void sift_down(TopN t, int i) {
+	while (2 * i + 1 < t->size) {
+		int child = 2 * i + 1;
+		if (child + 1 < t->size && worse(&t->heap[child + 1], &t->heap[child])) {
+			child++;
+		}
+		if (!worse(&t->heap[child], &t->heap[i])) break;
+		WFreq temp = t->heap[i];
+		t->heap[i] = t->heap[child];
+		t->heap[child] = temp;
+		i = child;
+	}
+}
@@ -0,0 +1,34 @@
+// COMP2521 21T2 Assignment 1
+// TopN.h ... interface to the top-N word selector
+// z5361442 James Teng
+// Keeps the best `n` of a stream of (word, frequency) pairs in a bounded
+// heap, in O(log n) per pair, with no limit on how many pairs are offered.
+// "Best" is the DictFindTopN order: higher frequency first, then
+// lexicographically smaller words.
+
+#ifndef TOPN_H
+#define TOPN_H
+
+#include "WFreq.h"
+
+typedef struct TopNRep *TopN;
+
+// Creates a selector that keeps the best `n` pairs
+TopN TopNNew(int n);
+
+// Frees the given selector (not the words offered to it)
+void TopNFree(TopN t);
+
+// Offers a pair to the selector. The word is not copied, so it must stay
+// valid until TopNFinish is called.
+void TopNOffer(TopN t, char *word, int freq);
+
+// Stores the kept pairs in `wfs` in DictFindTopN order and returns how
+// many there are. Assumes `wfs` has room for `n` pairs. The selector is
+// empty afterwards.
+int TopNFinish(TopN t, WFreq *wfs);
+
+// qsort compare function for the DictFindTopN order
+int order_sorter(const void *object_1, const void *object_2);
+
+#endif
@@ -0,0 +1,40 @@
+// COMP2521 21T2 Assignment 1
+// WordHash.h ... the word hash function shared by the hash tables
+// z5361442 James Teng
+// DictHash, StemCache, HeavyHitters and the stopword tables all hash words
+// the same way, so the function lives here once.
+
+#ifndef WORDHASH_H
+#define WORDHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define WORD_HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+// hashes a word eight bytes at a time (multiply-xorshift mixing). Each seed
+// gives a different hash function; seed 0 is the one hash_word uses.
+static inline uint64_t hash_word_seeded(const char *word, size_t length,
+                                        uint64_t seed) {
+	uint64_t hash = (seed ^ length) * WORD_HASH_MULTIPLIER;
+	size_t i = 0;
+	for (; i + 8 <= length; i += 8) {
+		uint64_t chunk;
+		memcpy(&chunk, word + i, 8);
+		hash = (hash ^ chunk) * WORD_HASH_MULTIPLIER;
+		hash ^= hash >> 29;
+	}
+	uint64_t tail = 0;
+	memcpy(&tail, word + i, length - i);
+	hash = (hash ^ tail) * WORD_HASH_MULTIPLIER;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+// hashes a word of `length` bytes
+static inline uint64_t hash_word(const char *word, size_t length) {
+	return hash_word_seeded(word, length, 0);
+}
+
+#endif
@@ -0,0 +1,278 @@
+// COMP2521 21T2 Assignment 1
+// mkstopwords.c ... generates the builtin stopword table
+// Usage: ./mkstopwords stopwords > StopwordsTable.h
+// z5361442 James Teng
+/* Builds a minimal perfect hash table for the words in the given file with
+the CHD ("compress, hash and displace") algorithm. Words are hashed into
+buckets of about BUCKET_LOAD words each; then, biggest bucket first, each
+bucket is given the first displacement that moves all of its words into
+free slots. The table has exactly one slot per word. The output is a C
+header for Stopwords.c, compiled in with -DSTOPWORDS_BUILTIN. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StopwordHash.h"
+
+#define BUCKET_LOAD 4
+#define MAX_SEEDS 1000
+// displacements are packed as d0 * size + d1 into 32 bits
+#define MAX_WORDS 65535
+
+typedef struct Word {
+	char *text;
+	size_t length;
+	uint64_t hash;
+} Word;
+
+// ***************************FUNCTION PROTOTYPES ******************************
+static int read_words(char *fileName, Word **words);
+static bool build_table(Word *words, int words_num, uint64_t seed,
+                        uint32_t *displacement, int buckets_num, int *table);
+static void print_table(char *fileName, Word *words, int words_num,
+                        uint64_t seed, uint32_t *displacement, int buckets_num,
+                        int *table);
+static void print_word(Word *word);
+static int word_order(const void *a, const void *b);
+// ***************************MAIN FUNCTION ************************************
+int main(int argc, char *argv[]) {
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s StopwordsFile\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	Word *words;
+	int words_num = read_words(argv[1], &words);
+	if (words_num == 0 || words_num > MAX_WORDS) {
+		fprintf(stderr, "%s must have between 1 and %d words\n", argv[1], MAX_WORDS);
+		exit(EXIT_FAILURE);
+	}
+
+	int buckets_num = (words_num + BUCKET_LOAD - 1) / BUCKET_LOAD;
+	uint32_t *displacement = malloc(buckets_num * sizeof(uint32_t));
+	int *table = malloc(words_num * sizeof(int));
+	assert(displacement != NULL && table != NULL);
+
+	// almost every seed works; retry with another if a bucket gets stuck
+	for (uint64_t seed = 1; seed <= MAX_SEEDS; seed++) {
+		if (build_table(words, words_num, seed, displacement, buckets_num, table)) {
+			print_table(argv[1], words, words_num, seed, displacement,
+			            buckets_num, table);
+			free(displacement);
+			free(table);
+			for (int i = 0; i < words_num; i++) {
+				free(words[i].text);
+			}
+			free(words);
+			return 0;
+		}
+	}
+	fprintf(stderr, "No perfect hash found for %s\n", argv[1]);
+	exit(EXIT_FAILURE);
+}
+
+//**************************FUNCTIONS ******************************************
+
+// reads the words (one per line, duplicates and empty lines dropped) from
+// the given file and returns how many there are
+static int read_words(char *fileName, Word **words) {
+	FILE *fp = fopen(fileName, "r");
+	if (fp == NULL) {
+		fprintf(stderr, "Can't open %s\n", fileName);
+		exit(EXIT_FAILURE);
+	}
+	// read the whole file, so lines can be any length
+	size_t capacity = 4096;
+	size_t length = 0;
+	char *text = malloc(capacity);
+	assert(text != NULL);
+	size_t got;
+	while ((got = fread(text + length, 1, capacity - length, fp)) > 0) {
+		length += got;
+		if (length == capacity) {
+			capacity *= 2;
+			text = realloc(text, capacity);
+			assert(text != NULL);
+		}
+	}
+	fclose(fp);
+
+	int words_num = 0;
+	*words = malloc((length + 1) * sizeof(Word));
+	assert(*words != NULL);
+	char *line = text;
+	char *end = text + length;
+	while (line < end) {
+		char *newline = memchr(line, '\n', end - line);
+		char *line_end = newline != NULL ? newline : end;
+		if (line_end > line) {
+			Word *word = &(*words)[words_num++];
+			word->length = line_end - line;
+			word->text = malloc(word->length + 1);
+			assert(word->text != NULL);
+			memcpy(word->text, line, word->length);
+			word->text[word->length] = '\0';
+		}
+		line = line_end + 1;
+	}
+	free(text);
+
+	// sort so duplicates are adjacent and the output is stable
+	qsort(*words, words_num, sizeof(Word), word_order);
+	int unique = 0;
+	for (int i = 0; i < words_num; i++) {
+		if (unique > 0 && word_order(&(*words)[unique - 1], &(*words)[i]) == 0) {
+			free((*words)[i].text);
+			continue;
+		}
+		(*words)[unique++] = (*words)[i];
+	}
+	return unique;
+}
+
+// tries to place every word with the given seed. On success fills in each
+// bucket's displacement and the word index in each slot of the table.
+static bool build_table(Word *words, int words_num, uint64_t seed,
+                        uint32_t *displacement, int buckets_num, int *table) {
+	size_t size = words_num;
+	// group the words by bucket (counting sort), remembering each bucket's
+	// range [first[b], first[b + 1])
+	int *first = calloc(buckets_num + 1, sizeof(int));
+	int *members = malloc(words_num * sizeof(int));
+	int *order = malloc(buckets_num * sizeof(int));
+	size_t *slots = malloc(words_num * sizeof(size_t));
+	assert(first != NULL && members != NULL && order != NULL && slots != NULL);
+	for (int i = 0; i < words_num; i++) {
+		words[i].hash = hash_word_seeded(words[i].text, words[i].length, seed);
+		first[words[i].hash % buckets_num + 1]++;
+	}
+	for (int b = 0; b < buckets_num; b++) {
+		first[b + 1] += first[b];
+	}
+	int *fill = malloc(buckets_num * sizeof(int));
+	assert(fill != NULL);
+	memcpy(fill, first, buckets_num * sizeof(int));
+	for (int i = 0; i < words_num; i++) {
+		members[fill[words[i].hash % buckets_num]++] = i;
+	}
+	free(fill);
+
+	// biggest buckets first (insertion sort keeps it deterministic)
+	for (int b = 0; b < buckets_num; b++) {
+		int j = b;
+		int b_size = first[b + 1] - first[b];
+		while (j > 0 && first[order[j - 1] + 1] - first[order[j - 1]] < b_size) {
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = b;
+	}
+
+	for (size_t s = 0; s < size; s++) {
+		table[s] = -1;
+	}
+	bool placed_all = true;
+	for (int k = 0; k < buckets_num && placed_all; k++) {
+		int b = order[k];
+		displacement[b] = 0;
+		int b_first = first[b];
+		int b_size = first[b + 1] - first[b];
+		if (b_size == 0) continue;
+
+		bool placed = false;
+		uint64_t tries = (uint64_t)size * size;
+		for (uint64_t d = 0; d < tries && !placed; d++) {
+			placed = true;
+			for (int m = 0; m < b_size && placed; m++) {
+				size_t s = stopword_slot(words[members[b_first + m]].hash,
+				                         (uint32_t)d, size);
+				if (table[s] != -1) {
+					placed = false;
+				}
+				// two words of the same bucket can't share a slot either
+				for (int p = 0; p < m && placed; p++) {
+					if (slots[p] == s) placed = false;
+				}
+				slots[m] = s;
+			}
+			if (placed) {
+				displacement[b] = (uint32_t)d;
+				for (int m = 0; m < b_size; m++) {
+					table[slots[m]] = members[b_first + m];
+				}
+			}
+		}
+		placed_all = placed;
+	}
+
+	free(first);
+	free(members);
+	free(order);
+	free(slots);
+	return placed_all;
+}
+
+// writes the generated header to stdout
+static void print_table(char *fileName, Word *words, int words_num,
+                        uint64_t seed, uint32_t *displacement, int buckets_num,
+                        int *table) {
+	printf("// StopwordsTable.h ... generated by mkstopwords from %s\n", fileName);
+	printf("// Do not edit; regenerate it when the stopwords file changes.\n\n");
+	printf("#ifndef STOPWORDSTABLE_H\n#define STOPWORDSTABLE_H\n\n");
+	printf("#include <stdint.h>\n\n");
+	printf("#define STOPWORDS_SEED %lluULL\n", (unsigned long long)seed);
+	printf("#define STOPWORDS_SIZE %d\n", words_num);
+	printf("#define STOPWORDS_BUCKETS %d\n\n", buckets_num);
+
+	printf("static const uint32_t stopword_displacement[STOPWORDS_BUCKETS] = {");
+	for (int b = 0; b < buckets_num; b++) {
+		printf("%s%lu,", b % 8 == 0 ? "\n\t" : " ", (unsigned long)displacement[b]);
+	}
+	printf("\n};\n\n");
+
+	printf("static const uint32_t stopword_length[STOPWORDS_SIZE] = {");
+	for (int s = 0; s < words_num; s++) {
+		printf("%s%zu,", s % 16 == 0 ? "\n\t" : " ", words[table[s]].length);
+	}
+	printf("\n};\n\n");
+
+	printf("static const char *const stopword_word[STOPWORDS_SIZE] = {\n");
+	for (int s = 0; s < words_num; s++) {
+		printf("\t");
+		print_word(&words[table[s]]);
+		printf(",\n");
+	}
+	printf("};\n\n#endif\n");
+}
+
+// prints a word as a C string literal
+static void print_word(Word *word) {
+	putchar('"');
+	for (size_t i = 0; i < word->length; i++) {
+		unsigned char c = word->text[i];
+		// '?' is escaped too so no trigraphs can appear
+		if (c < ' ' || c > '~' || c == '"' || c == '\\' || c == '?') {
+			printf("\\%03o", c);
+		}
+		else {
+			putchar(c);
+		}
+	}
+	putchar('"');
+}
+
+static int word_order(const void *a, const void *b) {
+	const Word *word_1 = a;
+	const Word *word_2 = b;
+	size_t shorter = word_1->length < word_2->length ? word_1->length : word_2->length;
+	int compare = memcmp(word_1->text, word_2->text, shorter);
+	if (compare != 0) return compare;
+	if (word_1->length != word_2->length) {
+		return word_1->length < word_2->length ? -1 : 1;
+	}
+	return 0;
+}
@@ -1,208 +1,606 @@
 // COMP2521 21T2 Assignment 1
 // tw.c ... compute top N most frequent words in file F
-// Usage: ./tw [Nwords] File
+// Usage: ./tw [-j Nthreads] [-b] [-s Ncounters [-v]] [Nwords] File
+//        -b: File is a directory, or a list of files one per line; shows the
+//            top N words of each file, then of all of them together
+//        -s: count in fixed memory, tracking at most Ncounters words; the
+//            counts shown are estimates
+//        -v: with -s, also count exactly and check the estimates
 // z5361442 James Teng - written in July 2021
 /* This file parses and reformats words from text-file and inserts words into a 
 BST implementation. Then prints out words and their frequencies from highest to 
 lowest. */
 
+// strdup and strndup are POSIX, not C11
+#define _POSIX_C_SOURCE 200809L
+
 #include <assert.h>
-#include <ctype.h>
+#include <dirent.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
+#include "BookText.h"
 #include "Dict.h"
+#include "DictExt.h"
+#include "HeavyHitters.h"
+#include "StemCache.h"
 #include "stemmer.h"
+#include "Stopwords.h"
+#include "Tokeniser.h"
 #include "WFreq.h"
 
-#define MAXLINE 1000
-#define MAXWORD 100
-#define STOPWORDS 654
-
-#define isWordChar(c) (isalnum(c) || (c) == '\'' || (c) == '-')
+#define STOPWORDS_FILE "stopwords"
+// names a stopwords file to use instead of the default list
+#define STOPWORDS_ENV "TW_STOPWORDS"
+// number of words whose stems are cached, unless $TW_STEM_CACHE says
+// otherwise (0 turns the cache off)
+#define STEM_CACHE_ENTRIES 4096
+#define STEM_CACHE_ENV "TW_STEM_CACHE"
+// if set, the stem cache statistics are printed to stderr at the end
+#define STEM_STATS_ENV "TW_STEM_STATS"
+// smallest piece of text worth giving its own thread
+#define MIN_SHARD 65536
 
 // ***************************FUNCTION PROTOTYPES ******************************
-void create_array(char stopword_array[STOPWORDS][MAXWORD]);
-int stopword_search(char stopword_array[STOPWORDS][MAXWORD], char search_word[MAXWORD]);
-void tokenise(char line[MAXLINE]);
-void bookwords_to_BST(char *fileName, Dict d, char stopword_array[STOPWORDS][MAXWORD]);
+Stopwords load_stopwords(void);
+StemCache new_stem_cache(void);
+void free_stem_cache(StemCache stems);
+void tokenise(const char *begin, const char *end, Dict d, Stopwords stopwords,
+              StemCache stems);
+bool run_stream(char *fileName, int nWords, int counters, bool verify,
+                Stopwords stopwords, StemCache stems);
+bool check_estimates(HeavyHitters hh, int counters, Dict d, WFreq *wfs,
+                     int found, int nWords);
+static void insert_word(char *token, size_t length, void *ctx);
+void tokenise_parallel(const char *begin, const char *end, Dict d,
+                       Stopwords stopwords, StemCache stems, int threads);
+static void *count_shard(void *arg);
+static void count_form(char *token, size_t length, void *ctx);
+static void add_form(char *word, int count, void *ctx);
+static void stem_form(char *word, int count, void *ctx);
+bool read_book(char *fileName, bool batch, BookPieceFn piece, void *ctx);
+static void count_piece(const char *begin, const char *end, void *ctx);
+static void stream_piece(const char *begin, const char *end, void *ctx);
+bool bookwords_to_BST(char *fileName, bool batch, Dict d,
+                      Stopwords stopwords, StemCache stems, int threads);
+void print_top_words(Dict d, WFreq *wfs, int nWords);
+int run_batch(char *listName, int nWords, Stopwords stopwords,
+              StemCache stems, int threads);
+int list_documents(char *listName, char ***names);
+static void add_name(char ***names, int *names_num, int *capacity, char *name);
+static int name_order(const void *a, const void *b);
 // ***************************MAIN FUNCTION ************************************
 int main(int argc, char *argv[]) {
 	int   nWords;    // number of top frequency words to show
 	char *fileName;  // name of file containing book text
+	int   threads = 1; // number of threads counting words
+	bool  batch = false; // if fileName lists the files to read
+	int   counters = 0;  // words tracked when counting in fixed memory
+	bool  verify = false; // if estimated counts are checked
 
-	// process command-line args
-	switch (argc) {
-		case 2:
+	// process command-line args; options come first
+	int arg = 1;
+	while (arg < argc) {
+		if (strcmp(argv[arg], "-j") == 0 && arg + 1 < argc) {
+			threads = atoi(argv[arg + 1]);
+			if (threads < 1) threads = 1;
+			arg += 2;
+		}
+		else if (strcmp(argv[arg], "-b") == 0) {
+			batch = true;
+			arg++;
+		}
+		else if (strcmp(argv[arg], "-s") == 0 && arg + 1 < argc) {
+			counters = atoi(argv[arg + 1]);
+			arg += 2;
+		}
+		else if (strcmp(argv[arg], "-v") == 0) {
+			verify = true;
+			arg++;
+		}
+		else {
+			break;
+		}
+	}
+	// fixed memory counting reads one file, and -v only applies to it
+	bool bad_options = (counters > 0 && batch) || (verify && counters <= 0);
+	switch (bad_options ? 0 : argc - arg) {
+		case 1:
 			nWords = 10;
-			fileName = argv[1];
+			fileName = argv[arg];
 			break;
-		case 3:
-			nWords = atoi(argv[1]);
+		case 2:
+			nWords = atoi(argv[arg]);
 			if (nWords < 10) nWords = 10;
-			fileName = argv[2];
+			fileName = argv[arg + 1];
 			break;
 		default:
-			fprintf(stderr,"Usage: %s [Nwords] File\n", argv[0]);
+			fprintf(stderr,"Usage: %s [-j Nthreads] [-b] [-s Ncounters [-v]] [Nwords] File\n", argv[0]);
 			exit(EXIT_FAILURE);
 	}
 
-	//declare array to store stopwords
-    char stopword_array[STOPWORDS][MAXWORD];
-	// adds stopwords into the "stopword_array"
-	create_array(stopword_array);
+	// set of words to leave out of the count
+	Stopwords stopwords = load_stopwords();
+	// stems of recently seen words
+	StemCache stems = new_stem_cache();
+	if (batch) {
+		int failed = run_batch(fileName, nWords, stopwords, stems, threads);
+		StopwordsFree(stopwords);
+		free_stem_cache(stems);
+		return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	if (counters > 0) {
+		bool ok = run_stream(fileName, nWords, counters, verify, stopwords, stems);
+		StopwordsFree(stopwords);
+		free_stem_cache(stems);
+		return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
 	
 	Dict d = DictNew();
 	// converts text to words which are stored in a binary search tree
-	bookwords_to_BST(fileName, d, stopword_array);
-
-	WFreq wfs[15000];	
-	int i = 0;
-	// read words into wfs array sorted by highest frequency to lowest frequency
-	// DictFindTopN returns the amount of words stored in the wfs array
-	int loop = DictFindTopN(d, wfs, nWords);
-	while (i < loop) {
-		printf("%d %s\n", wfs[i].freq, wfs[i].word);
-		i++;
+	if (!bookwords_to_BST(fileName, false, d, stopwords, stems, threads)) {
+		exit(EXIT_FAILURE);
 	}
+
+	WFreq *wfs = malloc(nWords * sizeof(WFreq));
+	assert(wfs != NULL);
+	print_top_words(d, wfs, nWords);
+	free(wfs);
 	// frees the "dictionary" (BST that stored the words) memory
 	DictFree(d);
+	StopwordsFree(stopwords);
+	free_stem_cache(stems);
 }
 
 
 //**************************FUNCTIONS ******************************************
-//creates an array for stopwords
-void create_array(char stopword_array[STOPWORDS][MAXWORD]) {
-	FILE *fp = fopen("stopwords", "r");
+// returns the stopwords: the list compiled into tw (if it was built with
+// -DSTOPWORDS_BUILTIN), or else the list read from the stopwords file. A
+// file named by $TW_STOPWORDS replaces either.
+Stopwords load_stopwords(void) {
+	char *fileName = getenv(STOPWORDS_ENV);
+	if (fileName == NULL) {
+		Stopwords builtin = StopwordsBuiltin();
+		if (builtin != NULL) {
+			return builtin;
+		}
+		fileName = STOPWORDS_FILE;
+	}
+	Stopwords stopwords = StopwordsLoad(fileName);
 	// error handling if there is no stopwords file
-	if (fp == NULL) {
-		fprintf(stderr, "Can't open %s\n", "stopwords");
+	if (stopwords == NULL) {
+		fprintf(stderr, "Can't open %s\n", fileName);
 		exit(EXIT_FAILURE);
 	}
-	char line[MAXLINE + 1];
+	return stopwords;
+}
+
+// returns a stem cache of the size given by $TW_STEM_CACHE (or the
+// default size), or NULL if the cache is turned off
+StemCache new_stem_cache(void) {
+	int entries = STEM_CACHE_ENTRIES;
+	char *env = getenv(STEM_CACHE_ENV);
+	if (env != NULL) {
+		entries = atoi(env);
+	}
+	return entries > 0 ? StemCacheNew(entries) : NULL;
+}
 
-	int counter = 0;
-	//reads in all lines in the text document
-	while (fgets(line, MAXLINE + 1, fp) != NULL) {
-		// replaces \n with \0
-		line[strcspn(line, "\n")] = '\0';
-		// copies the line that was read in, into the stopword_array
-		strcpy(stopword_array[counter], line);
-		counter++;
+// frees the stem cache, first printing its statistics if $TW_STEM_STATS
+// is set
+void free_stem_cache(StemCache stems) {
+	if (stems == NULL) return;
+	if (getenv(STEM_STATS_ENV) != NULL) {
+		StemCacheShowStats(stems, stderr);
 	}
-	fclose(fp);
+	StemCacheFree(stems);
 }
 
-//binary search algorithm in an array, to check if a given word is a stopword
-int stopword_search(char stopword_array[STOPWORDS][MAXWORD], char search_word[MAXWORD]) {
-	int low = 0;
-	int high = STOPWORDS - 1;
-	int compare = 0;
+// what each word found by the tokeniser is counted into
+struct WordSink {
+	Dict d;              // NULL if words are not counted exactly
+	Stopwords stopwords;
+	StemCache stems;     // NULL if every word goes to the stemmer
+	HeavyHitters hh;     // NULL unless words are counted in fixed memory
+};
 
-	while (low <= high) {
-		// halves the middle index to narrow our search
-		int mid = (high + low) / 2;
-		// compares the middle (current) word in the array to the search word
-		compare = strcmp(stopword_array[mid], search_word);
-		if (compare > 0) {
-			high = mid - 1;
+// splits the text between `begin` and `end` into lower-cased words and
+// stores every word that is not a stopword, once stemmed, in the binary
+// search tree
+void tokenise(const char *begin, const char *end, Dict d, Stopwords stopwords,
+              StemCache stems) {
+	struct WordSink sink = {d, stopwords, stems, NULL};
+	TokeniseText(begin, end, insert_word, &sink);
+}
+
+// filters, stems and stores a single word from the tokeniser
+static void insert_word(char *token, size_t length, void *ctx) {
+	struct WordSink *sink = ctx;
+	// runs if word is more than one character
+	if (length > 1) {
+		// runs if word is not a stopword
+		if (!StopwordsContains(sink->stopwords, token, length)) {
+			// stem word
+			if (sink->stems != NULL) {
+				StemCacheStem(sink->stems, token, length);
+			}
+			else {
+				stem(token, 0, length - 1);
+			}
+			// insert word into binary search tree
+			if (sink->d != NULL) {
+				DictInsert(sink->d, token);
+			}
+			if (sink->hh != NULL) {
+				HeavyHittersInsert(sink->hh, token);
+			}
+		}
+	}
+}
+
+// one thread's share of the text in tokenise_parallel
+struct Shard {
+	const char *begin;
+	const char *end;
+	Stopwords stopwords;
+	Dict forms;          // words as they appear in the text, not stemmed
+};
+
+// does the same as tokenise, splitting the text between `threads` threads.
+// The stemmer keeps its state in globals, so the threads only filter and
+// count the words as they appear in the text; each distinct word is then
+// stemmed once, on this thread, while the shards are merged.
+void tokenise_parallel(const char *begin, const char *end, Dict d,
+                       Stopwords stopwords, StemCache stems, int threads) {
+	if (threads > (end - begin) / MIN_SHARD) {
+		threads = (end - begin) / MIN_SHARD;
+	}
+	if (threads < 2) {
+		tokenise(begin, end, d, stopwords, stems);
+		return;
+	}
+
+	// cut the text into roughly equal shards, moving each cut forward to
+	// whitespace so no word is split between two shards
+	struct Shard *shards = malloc(threads * sizeof(struct Shard));
+	pthread_t *ids = malloc(threads * sizeof(pthread_t));
+	assert(shards != NULL && ids != NULL);
+	const char *cut = begin;
+	for (int t = 0; t < threads; t++) {
+		shards[t].begin = cut;
+		const char *target = begin + (end - begin) / threads * (t + 1);
+		if (t == threads - 1) {
+			target = end;
 		}
-		else if (compare < 0) {
-			low = mid + 1;
+		if (target > cut) {
+			cut = target;
 		}
-		// if word has been matched
-		else {
-			return mid;
+		while (cut < end && *cut != ' ' && *cut != '\n' && *cut != '\t' &&
+		       *cut != '\r') {
+			cut++;
 		}
+		shards[t].end = cut;
+		shards[t].stopwords = stopwords;
+		shards[t].forms = DictNew();
 	}
-	// word not found
-	return -1;
+
+	for (int t = 0; t < threads; t++) {
+		if (pthread_create(&ids[t], NULL, count_shard, &shards[t]) != 0) {
+			fprintf(stderr, "Can't create word counting thread\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	for (int t = 0; t < threads; t++) {
+		pthread_join(ids[t], NULL);
+	}
+
+	// merge every shard into the first, then stem each distinct word once
+	Dict forms = shards[0].forms;
+	for (int t = 1; t < threads; t++) {
+		DictForEach(shards[t].forms, add_form, forms);
+		DictFree(shards[t].forms);
+	}
+	DictForEach(forms, stem_form, d);
+	DictFree(forms);
+	free(shards);
+	free(ids);
 }
 
-// replaces non-valid characters with space and turns capital letters into 
-// lowercase
-void tokenise(char line[MAXLINE]) {
-	int i = 0;
-	// iterate through line
-	while (line[i] != '\0') {
-		if (!isWordChar(line[i])) {
-			// replace non-valid characters with space
-			line[i] = ' ';
-		}
-		// replaces capital letters with lower-case letters
-		line[i] = tolower(line[i]);
-		i++;
+// counts the words in one shard
+static void *count_shard(void *arg) {
+	struct Shard *shard = arg;
+	TokeniseText(shard->begin, shard->end, count_form, shard);
+	return NULL;
+}
+
+// filters and counts a single word from a shard, without stemming it
+static void count_form(char *token, size_t length, void *ctx) {
+	struct Shard *shard = ctx;
+	if (length > 1 && !StopwordsContains(shard->stopwords, token, length)) {
+		DictInsert(shard->forms, token);
 	}
-	
 }
 
+// adds a word and its count to another Dictionary (the merged shards, or
+// the whole batch)
+static void add_form(char *word, int count, void *ctx) {
+	DictAdd(ctx, word, count);
+}
+
+// stems a merged word and adds its count to the binary search tree
+static void stem_form(char *word, int count, void *ctx) {
+	// the stemmer works in place, and `word` belongs to the Dictionary
+	size_t length = strlen(word);
+	char *copy = malloc(length + 1);
+	assert(copy != NULL);
+	memcpy(copy, word, length + 1);
+	stem(copy, 0, length - 1);
+	DictAdd(ctx, copy, count);
+	free(copy);
+}
+
+// what count_piece counts a book's words into
+struct BookCount {
+	Dict d;
+	Stopwords stopwords;
+	StemCache stems;
+	int threads;
+};
+
 // reads in a file and converts the text into formatted words which are then 
-// stored in a binary search tree
-void bookwords_to_BST(char *fileName, Dict d, char stopword_array[STOPWORDS][MAXWORD]) {
-	// create a file pointer and open selected file
-	FILE *fp = fopen(fileName, "r");
+// stored in a binary search tree. Returns false (after reporting why) if
+// the file can't be read or is not a Project Gutenberg book; words read
+// from a stream before that was found out may already be in the tree.
+// `batch` is passed on to read_book.
+bool bookwords_to_BST(char *fileName, bool batch, Dict d,
+                      Stopwords stopwords, StemCache stems, int threads) {
+	struct BookCount count = {d, stopwords, stems, threads};
+	return read_book(fileName, batch, count_piece, &count);
+}
+
+// passes the text between the "*** START OF" and "*** END OF" lines of
+// the file to `piece`: all at once if the file is mapped, or a buffer at
+// a time if it is a pipe. Returns false (after reporting why) if the file
+// can't be read or is not a Project Gutenberg book; in `batch` mode the
+// report names the file, as it is one of many.
+bool read_book(char *fileName, bool batch, BookPieceFn piece, void *ctx) {
+	BookStatus status = BookTextForEachPiece(fileName, piece, ctx);
 	// error handling if file name on command-line is non-existent/unreadable
-	if (fp == NULL) {
+	if (status == BOOK_UNREADABLE) {
 		fprintf(stderr, "Can't open %s\n", fileName);
-		exit(EXIT_FAILURE);
+		return false;
 	}
-	
-	char line[MAXLINE];
-	
-	// declare starting string
-	char *begin = "*** START OF";
-	int begin_length = strlen(begin);
-	// declare ending string
-	char *end = "*** END OF";
-	int end_length = strlen(end);
-	int found_start = 0;
-	int found_end = 0;
-	
-	//reads in all lines in the text document
-	while (fgets(line, MAXLINE, fp) != NULL) {
-		// checks if the current line matches the starting string
-		if (found_start == 0 && strncmp(line, begin, begin_length) == 0) {
-			found_start = 1;
-		}
-		// checks if the current line matches the ending string
-		else if (found_end == 0 && strncmp(line, end, end_length) == 0) {
-			found_end = 1;
-			break;
+	// error handling if either line is missing
+	if (status == BOOK_NOT_GUTENBERG) {
+		if (batch) {
+			fprintf(stderr, "%s: Not a Project Gutenberg book\n", fileName);
+		}
+		else {
+			fprintf(stderr, "Not a Project Gutenberg book\n");
+		}
+		return false;
+	}
+	return true;
+}
+
+// counts the words in a piece of a book into a Dictionary
+static void count_piece(const char *begin, const char *end, void *ctx) {
+	struct BookCount *count = ctx;
+	// tokenise the text in place, without copying it line by line
+	if (count->threads > 1) {
+		tokenise_parallel(begin, end, count->d, count->stopwords,
+		                  count->stems, count->threads);
+	}
+	else {
+		tokenise(begin, end, count->d, count->stopwords, count->stems);
+	}
+}
+
+// passes the words in a piece of a book to a WordSink
+static void stream_piece(const char *begin, const char *end, void *ctx) {
+	TokeniseText(begin, end, insert_word, ctx);
+}
+
+// counts the words of the book in fixed memory, tracking at most
+// `counters` words, and shows the top `nWords` with their estimated counts.
+// With `verify` the words are also counted exactly in a Dictionary and the
+// estimates are checked against it. Returns false if the book can't be
+// read or an estimate is wrong.
+bool run_stream(char *fileName, int nWords, int counters, bool verify,
+                Stopwords stopwords, StemCache stems) {
+	HeavyHitters hh = HeavyHittersNew(counters);
+	Dict d = verify ? DictNew() : NULL;
+	struct WordSink sink = {d, stopwords, stems, hh};
+	if (!read_book(fileName, false, stream_piece, &sink)) {
+		if (d != NULL) {
+			DictFree(d);
 		}
-		// runs after the starting string is found
-		else if (found_start == 1) {
-			tokenise(line);
-			// extract words using space as a delimiter 
-			char* token = strtok(line, " ");
-			// extracts all words in the line string
-			while (token != NULL) {
-				// runs if word is more than one character
-				if (strlen(token) > 1) {
-					// runs if word is not a stopword
-					if (stopword_search(stopword_array, token) == -1) {
-						// stem word
-						stem(token, 0, strlen(token) - 1);
-						// insert word into binary search tree
-						DictInsert(d, token);
-					}
-				}
-				token = strtok(NULL, " ");
+		HeavyHittersFree(hh);
+		return false;
+	}
+
+	WFreq *wfs = malloc(nWords * sizeof(WFreq));
+	assert(wfs != NULL);
+	int found = HeavyHittersTopN(hh, wfs, nWords);
+	for (int i = 0; i < found; i++) {
+		printf("%d %s\n", wfs[i].freq, wfs[i].word);
+	}
+	bool ok = true;
+	if (verify) {
+		ok = check_estimates(hh, counters, d, wfs, found, nWords);
+		DictFree(d);
+	}
+	free(wfs);
+	HeavyHittersFree(hh);
+	return ok;
+}
+
+// prints each estimated count next to the exact count and the most it may
+// be over by, marking any that is out of bounds with "!", then how many of
+// the exact top `nWords` were found and the bound on every error (words
+// counted / `counters`). Returns false if any estimate is out
+// of bounds.
+bool check_estimates(HeavyHitters hh, int counters, Dict d, WFreq *wfs,
+                     int found, int nWords) {
+	printf("==> estimate exact error <==\n");
+	bool ok = true;
+	for (int i = 0; i < found; i++) {
+		int exact = DictFind(d, wfs[i].word);
+		int error = HeavyHittersError(hh, wfs[i].word);
+		bool in_bounds = exact <= wfs[i].freq && wfs[i].freq <= exact + error;
+		printf("%d %d %d %s%s\n", wfs[i].freq, exact, error, wfs[i].word,
+		       in_bounds ? "" : " !");
+		if (!in_bounds) ok = false;
+	}
+
+	WFreq *exact_top = malloc(nWords * sizeof(WFreq));
+	assert(exact_top != NULL);
+	int exact_found = DictFindTopN(d, exact_top, nWords);
+	int recalled = 0;
+	for (int i = 0; i < exact_found; i++) {
+		for (int j = 0; j < found; j++) {
+			if (strcmp(exact_top[i].word, wfs[j].word) == 0) {
+				recalled++;
+				break;
 			}
 		}
 	}
-	// error handling if can't find the "*** START OF" line
-	if (found_start == 0) {
-		fprintf(stderr, "Not a Project Gutenberg book\n");
-		exit(EXIT_FAILURE);
+	printf("%d of the exact top %d found (%ld words, error bound %ld)\n",
+	       recalled, exact_found, HeavyHittersTotal(hh),
+	       HeavyHittersTotal(hh) / counters);
+	free(exact_top);
+	return ok;
+}
+
+// prints the top `nWords` words of the Dictionary, using `wfs` (of size
+// `nWords`) as scratch space
+void print_top_words(Dict d, WFreq *wfs, int nWords) {
+	int i = 0;
+	// read words into wfs array sorted by highest frequency to lowest frequency
+	// DictFindTopN returns the amount of words stored in the wfs array
+	int loop = DictFindTopN(d, wfs, nWords);
+	while (i < loop) {
+		printf("%d %s\n", wfs[i].freq, wfs[i].word);
+		i++;
 	}
-	// error handling if EOF encountered before "*** END OF" line
-	else if (found_end == 0) {
-		fprintf(stderr, "Not a Project Gutenberg book\n");
-		exit(EXIT_FAILURE);
+}
+
+// shows the top words of every file named by `listName` (a directory or a
+// list of files) and then of all of them together. The stopwords, the stem
+// cache and the Dictionary are set up once and reused for every file. Files that can't
+// be read are reported and skipped; returns how many there were, or -1 if
+// `listName` itself can't be read.
+int run_batch(char *listName, int nWords, Stopwords stopwords,
+              StemCache stems, int threads) {
+	char **names;
+	int names_num = list_documents(listName, &names);
+	if (names_num < 0) {
+		fprintf(stderr, "Can't open %s\n", listName);
+		return -1;
+	}
+
+	Dict d = DictNew();
+	Dict corpus = DictNew();
+	WFreq *wfs = malloc(nWords * sizeof(WFreq));
+	assert(wfs != NULL);
+	int failed = 0;
+	int counted = 0;
+	for (int i = 0; i < names_num; i++) {
+		if (!bookwords_to_BST(names[i], true, d, stopwords, stems,
+		                      threads)) {
+			// a stream may have been partly counted
+			DictClear(d);
+			failed++;
+			continue;
+		}
+		printf("%s==> %s <==\n", counted > 0 ? "\n" : "", names[i]);
+		print_top_words(d, wfs, nWords);
+		DictForEach(d, add_form, corpus);
+		DictClear(d);
+		counted++;
+	}
+	printf("%s==> total (%d files) <==\n", counted > 0 ? "\n" : "", counted);
+	print_top_words(corpus, wfs, nWords);
+
+	free(wfs);
+	DictFree(d);
+	DictFree(corpus);
+	for (int i = 0; i < names_num; i++) {
+		free(names[i]);
 	}
-	//closes file 
-	fclose(fp);
+	free(names);
+	return failed;
 }
 
+// stores the names of the files to read in a malloc'd array and returns
+// how many there are, or -1 if `listName` can't be read. A directory gives
+// every regular file in it (except hidden ones) in name order; any other
+// file is read as a list of names, one per line.
+int list_documents(char *listName, char ***names) {
+	int names_num = 0;
+	int capacity = 16;
+	*names = malloc(capacity * sizeof(char *));
+	assert(*names != NULL);
+
+	struct stat info;
+	if (stat(listName, &info) == 0 && S_ISDIR(info.st_mode)) {
+		DIR *dir = opendir(listName);
+		if (dir == NULL) {
+			free(*names);
+			return -1;
+		}
+		struct dirent *entry;
+		while ((entry = readdir(dir)) != NULL) {
+			if (entry->d_name[0] == '.') continue;
+			char *path = malloc(strlen(listName) + strlen(entry->d_name) + 2);
+			assert(path != NULL);
+			sprintf(path, "%s/%s", listName, entry->d_name);
+			if (stat(path, &info) == 0 && S_ISREG(info.st_mode)) {
+				add_name(names, &names_num, &capacity, path);
+			}
+			free(path);
+		}
+		closedir(dir);
+		qsort(*names, names_num, sizeof(char *), name_order);
+		return names_num;
+	}
+
+	BookText list;
+	if (!BookTextOpen(listName, &list)) {
+		free(*names);
+		return -1;
+	}
+	const char *line = list.data;
+	const char *end = list.data + list.length;
+	while (line < end) {
+		const char *newline = memchr(line, '\n', end - line);
+		const char *line_end = newline != NULL ? newline : end;
+		if (line_end > line) {
+			char *name = strndup(line, line_end - line);
+			assert(name != NULL);
+			add_name(names, &names_num, &capacity, name);
+			free(name);
+		}
+		line = line_end + 1;
+	}
+	BookTextClose(&list);
+	return names_num;
+}
+
+// appends a copy of the name to the growing array of names
+static void add_name(char ***names, int *names_num, int *capacity, char *name) {
+	if (*names_num == *capacity) {
+		*capacity *= 2;
+		*names = realloc(*names, *capacity * sizeof(char *));
+		assert(*names != NULL);
+	}
+	(*names)[(*names_num)++] = strdup(name);
+}
+
+static int name_order(const void *a, const void *b) {
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
@@ -0,0 +1,394 @@
+// Approximate Centrality Measures API implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Betweenness: each sample picks a random (src, dest) pair, runs dijkstra
+// from src into a reused workspace until dest is settled and, if dest was
+// reached, walks back one shortest path chosen uniformly at random (at each
+// step a predecessor u of w is taken with probability sigma[u] / sigma[w]).
+// Every vertex strictly inside the path scores a hit; hits / samples
+// estimates the betweenness divided by n(n - 1).
+//
+// The sample size bound needs the vertex diameter (most vertices on any
+// shortest path). Bounding it for a weighted digraph would itself take all
+// sources, so n is used instead; it only enters through log2, so this
+// costs a few extra samples at most.
+//
+// Closeness: HyperBall with one round per unit of distance. Weights are
+// first divided by their gcd; with weights of at most L units, the counters
+// at distance t only read those at t - 1 .. t - L, so L + 1 layers of
+// counters are kept in a ring. A counter at distance t is the one at t - 1
+// joined with each out neighbour's at t - weight, but only the neighbours
+// whose counter grew at that distance can add anything new, so the rest are
+// skipped. Once no counter has grown for L rounds in a row none ever will.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Dijkstra.h defines INFINITY as INT_MAX for int distances
+#undef INFINITY
+
+#include "ApproxCentrality.h"
+#include "CentralityEngine.h"
+#include "CentralityMeasures.h"
+#include "CentralityVariants.h"
+#include "Dijkstra.h"
+#include "DijkstraWorkspace.h"
+#include "GraphCSR.h"
+#include "Rng.h"
+
+// the constant c in the Riondato-Kornaropoulos sample size
+#define SAMPLE_CONSTANT 0.5
+
+#define MIN_REGISTER_BITS 4
+#define MAX_REGISTER_BITS 16
+
+typedef uint8_t Register;
+
+// HyperLogLog counters of every vertex at the last `layers` distances
+struct BallLayers {
+	int numNodes;
+	int registerBits;
+	int registers;          // 2^registerBits per counter
+	int layers;
+	Register *counters;     // layers * numNodes * registers
+	bool *grew;             // layers * numNodes: counter grew at that distance
+};
+
+//***********************FUNCTION DECLARATIONS**********************************
+static double now_seconds(void);
+static void count_paths(DijkstraWorkspace ws, double *sigma);
+static void sample_path(DijkstraWorkspace ws, Vertex dest, double *sigma,
+                        Rng *rng, double *hits);
+static int weight_gcd(GraphCSR csr);
+static Register *counter_at(struct BallLayers *balls, int t, Vertex v);
+static bool *grew_at(struct BallLayers *balls, int t, Vertex v);
+static void counter_add(Register *counter, int registerBits, uint64_t hash);
+static bool counter_union(Register *dest, Register *src, int registers);
+static double counter_size(Register *counter, int registers);
+//******************************************************************************
+
+ApproxOptions approxDefaultOptions(void) {
+	ApproxOptions opts = { 0.01, 0.1, 0, 1 };
+	return opts;
+}
+
+int betweennessSampleSize(int numNodes, double epsilon, double delta) {
+	assert(epsilon > 0 && delta > 0 && delta < 1);
+	// floor(log2(VD - 2)), with the vertex diameter VD bounded by n
+	int log_diameter = 0;
+	for (int d = numNodes - 2; d > 1; d /= 2) {
+		log_diameter++;
+	}
+	double r = SAMPLE_CONSTANT / (epsilon * epsilon) *
+	           (log_diameter + 1 + log(1 / delta));
+	return r >= INT_MAX ? INT_MAX : (int)ceil(r);
+}
+
+NodeValues betweennessCentralityApprox(Graph g, ApproxOptions opts,
+                                       ApproxReport *report) {
+	GraphCSR csr = GraphCSRNewOut(g);
+	NodeValues nvs = betweennessCentralityApproxCSR(csr, opts, report);
+	GraphCSRFree(csr);
+	return nvs;
+}
+
+NodeValues betweennessCentralityApproxCSR(GraphCSR csr, ApproxOptions opts,
+                                          ApproxReport *report) {
+	double start = now_seconds();
+	int n = csr->numNodes;
+	NodeValues nvs = {0};
+	nvs.numNodes = n;
+	nvs.values = calloc(n > 0 ? n : 1, sizeof(double));
+	assert(nvs.values != NULL);
+
+	int planned = n > 2 ? betweennessSampleSize(n, opts.epsilon, opts.delta) : 0;
+	int taken = 0;
+	if (planned > 0) {
+		DijkstraWorkspace ws = dijkstraWorkspaceNew(n);
+		double *sigma = malloc(n * sizeof(double));
+		assert(sigma != NULL);
+		Rng rng = RngNew(opts.seed);
+		for (; taken < planned; taken++) {
+			if (opts.timeBudget > 0 && now_seconds() - start >= opts.timeBudget) {
+				break;
+			}
+			Vertex src = RngInt(&rng, n);
+			Vertex dest = RngInt(&rng, n - 1);
+			if (dest >= src) dest++;
+			dijkstraCSRIntoTarget(csr, src, dest, ws);
+			if (dijkstraWorkspaceDist(ws, dest) != INFINITY) {
+				count_paths(ws, sigma);
+				sample_path(ws, dest, sigma, &rng, nvs.values);
+			}
+		}
+		free(sigma);
+		dijkstraWorkspaceFree(ws);
+
+		// hits / samples estimates betweenness / n(n - 1)
+		double scale = taken > 0 ? (double)n * (n - 1) / taken : 0;
+		for (int v = 0; v < n; v++) {
+			nvs.values[v] *= scale;
+		}
+	}
+
+	if (report != NULL) {
+		report->samplesPlanned = planned;
+		report->samplesTaken = taken;
+		report->seconds = now_seconds() - start;
+	}
+	return nvs;
+}
+
+NodeValues betweennessCentralityNormalisedApprox(Graph g, ApproxOptions opts,
+                                                 ApproxReport *report) {
+	NodeValues nvs = betweennessCentralityApprox(g, opts, report);
+	for (int i = 0; i < nvs.numNodes; i++) {
+		nvs.values[i] = betweennessNormalise(nvs.numNodes, nvs.values[i]);
+	}
+	return nvs;
+}
+
+int hyperBallRegisterBits(double epsilon) {
+	assert(epsilon > 0);
+	// the relative standard error is about 1.04 / sqrt(registers)
+	double registers = (1.04 / epsilon) * (1.04 / epsilon);
+	int bits = MIN_REGISTER_BITS;
+	while (bits < MAX_REGISTER_BITS && (double)(1 << bits) < registers) {
+		bits++;
+	}
+	return bits;
+}
+
+NodeValues closenessCentralityHyperBall(Graph g, int registerBits,
+                                        uint64_t seed) {
+	GraphCSR csr = GraphCSRNewOut(g);
+	NodeValues nvs = closenessCentralityHyperBallCSR(csr, registerBits, seed);
+	GraphCSRFree(csr);
+	return nvs;
+}
+
+NodeValues closenessCentralityHyperBallCSR(GraphCSR csr, int registerBits,
+                                           uint64_t seed) {
+	assert(registerBits >= MIN_REGISTER_BITS && registerBits <= MAX_REGISTER_BITS);
+	int n = csr->numNodes;
+	NodeValues nvs = {0};
+	nvs.numNodes = n;
+	nvs.values = calloc(n > 0 ? n : 1, sizeof(double));
+	assert(nvs.values != NULL);
+	// with no edges nothing reaches anything, and every value is 0
+	if (csr->numEdges == 0) {
+		return nvs;
+	}
+
+	int unit = weight_gcd(csr);
+	int max_units = csr->maxWeight / unit;
+	struct BallLayers balls;
+	balls.numNodes = n;
+	balls.registerBits = registerBits;
+	balls.registers = 1 << registerBits;
+	balls.layers = max_units + 1;
+	balls.counters = calloc((size_t)balls.layers * n * balls.registers,
+	                        sizeof(Register));
+	balls.grew = calloc((size_t)balls.layers * n, sizeof(bool));
+	double *size = malloc(n * sizeof(double));       // at the last distance
+	double *dist_sum = calloc(n, sizeof(double));
+	assert(balls.counters != NULL && balls.grew != NULL);
+	assert(size != NULL && dist_sum != NULL);
+
+	// at distance 0 each vertex reaches only itself
+	for (Vertex v = 0; v < n; v++) {
+		Rng rng = RngNew(seed ^ ((uint64_t)v * 0xD6E8FEB86659FD93ULL));
+		Register *counter = counter_at(&balls, 0, v);
+		counter_add(counter, registerBits, RngNext(&rng));
+		*grew_at(&balls, 0, v) = true;
+		size[v] = counter_size(counter, balls.registers);
+	}
+
+	int quiet_rounds = 0;
+	for (int t = 1; quiet_rounds < max_units; t++) {
+		bool any_grew = false;
+		for (Vertex v = 0; v < n; v++) {
+			Register *counter = counter_at(&balls, t, v);
+			memcpy(counter, counter_at(&balls, t - 1, v),
+			       balls.registers * sizeof(Register));
+			bool grew = false;
+			for (int e = csr->outOffset[v]; e < csr->outOffset[v + 1]; e++) {
+				int from = t - csr->outWeight[e] / unit;
+				Vertex w = csr->outVertex[e];
+				if (from >= 0 && *grew_at(&balls, from, w)) {
+					grew |= counter_union(counter, counter_at(&balls, from, w),
+					                      balls.registers);
+				}
+			}
+			*grew_at(&balls, t, v) = grew;
+			if (grew) {
+				// the vertices first reached at distance t
+				double new_size = counter_size(counter, balls.registers);
+				dist_sum[v] += (double)t * unit * (new_size - size[v]);
+				size[v] = new_size;
+				any_grew = true;
+			}
+		}
+		quiet_rounds = any_grew ? 0 : quiet_rounds + 1;
+	}
+
+	for (Vertex v = 0; v < n; v++) {
+		nvs.values[v] = closenessFromSums(dist_sum[v], n, size[v]);
+	}
+	free(balls.counters);
+	free(balls.grew);
+	free(size);
+	free(dist_sum);
+	return nvs;
+}
+
+BetweennessComparison betweennessCompareApprox(Graph g, ApproxOptions opts) {
+	BetweennessComparison cmp = {0};
+	GraphCSR csr = GraphCSRNewOut(g);
+	int n = csr->numNodes;
+
+	double start = now_seconds();
+	NodeValues exact = betweennessCentralityCSR(csr);
+	cmp.exactSeconds = now_seconds() - start;
+	NodeValues approx = betweennessCentralityApproxCSR(csr, opts, &cmp.report);
+	cmp.approxSeconds = cmp.report.seconds;
+
+	// a graph with fewer than two vertices has no pairs and no error
+	double pairs = n > 1 ? (double)n * (n - 1) : 1;
+	for (int v = 0; v < n; v++) {
+		double error = fabs(approx.values[v] - exact.values[v]) / pairs;
+		if (error > cmp.maxError) cmp.maxError = error;
+		if (error > opts.epsilon) cmp.outsideEpsilon++;
+		cmp.meanError += error;
+	}
+	if (n > 0) cmp.meanError /= n;
+
+	freeNodeValues(exact);
+	freeNodeValues(approx);
+	GraphCSRFree(csr);
+	return cmp;
+}
+
+//******************************HELPER FUNCTIONS********************************
+
+static double now_seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// counts the shortest paths from the source to each settled vertex
+static void count_paths(DijkstraWorkspace ws, double *sigma) {
+	for (int i = 0; i < ws->numSettled; i++) {
+		Vertex w = ws->settled[i];
+		sigma[w] = w == ws->src ? 1 : 0;
+		for (PredNode *curr = ws->pred[w]; curr != NULL; curr = curr->next) {
+			sigma[w] += sigma[curr->v];
+		}
+	}
+}
+
+// returns the greatest common divisor of the edge weights
+static int weight_gcd(GraphCSR csr) {
+	int gcd = 0;
+	for (int e = 0; e < csr->numEdges && gcd != 1; e++) {
+		int a = csr->outWeight[e];
+		int b = gcd;
+		while (b != 0) {
+			int r = a % b;
+			a = b;
+			b = r;
+		}
+		gcd = a;
+	}
+	return gcd;
+}
+
+static Register *counter_at(struct BallLayers *balls, int t, Vertex v) {
+	size_t layer = t % balls->layers;
+	return balls->counters +
+	       (layer * balls->numNodes + v) * (size_t)balls->registers;
+}
+
+static bool *grew_at(struct BallLayers *balls, int t, Vertex v) {
+	return balls->grew + (size_t)(t % balls->layers) * balls->numNodes + v;
+}
+
+// adds an item to a counter: the top bits of its hash pick a register,
+// which keeps the longest run of leading zeros (plus one) seen in the rest
+static void counter_add(Register *counter, int registerBits, uint64_t hash) {
+	int index = (int)(hash >> (64 - registerBits));
+	uint64_t rest = hash << registerBits;
+	int max_rank = 64 - registerBits + 1;
+	int rank = 1;
+	while (rank < max_rank && (rest & (1ULL << 63)) == 0) {
+		rest <<= 1;
+		rank++;
+	}
+	if (rank > counter[index]) {
+		counter[index] = rank;
+	}
+}
+
+// joins src into dest, returning true if dest changed
+static bool counter_union(Register *dest, Register *src, int registers) {
+	bool changed = false;
+	for (int i = 0; i < registers; i++) {
+		if (src[i] > dest[i]) {
+			dest[i] = src[i];
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+// the HyperLogLog estimate, with linear counting for small sets
+static double counter_size(Register *counter, int registers) {
+	double alpha;
+	switch (registers) {
+	case 16: alpha = 0.673; break;
+	case 32: alpha = 0.697; break;
+	case 64: alpha = 0.709; break;
+	default: alpha = 0.7213 / (1 + 1.079 / registers); break;
+	}
+	double harmonic = 0;
+	int zeros = 0;
+	for (int i = 0; i < registers; i++) {
+		harmonic += ldexp(1.0, -counter[i]);
+		if (counter[i] == 0) zeros++;
+	}
+	double estimate = alpha * registers * registers / harmonic;
+	if (estimate <= 2.5 * registers && zeros > 0) {
+		estimate = registers * log((double)registers / zeros);
+	}
+	return estimate;
+}
+
+// walks back from dest along a uniformly random shortest path, adding a
+// hit to every vertex strictly between the source and dest
+static void sample_path(DijkstraWorkspace ws, Vertex dest, double *sigma,
+                        Rng *rng, double *hits) {
+	Vertex w = dest;
+	while (w != ws->src) {
+		double pick = RngDouble(rng) * sigma[w];
+		PredNode *curr = ws->pred[w];
+		// the last predecessor also takes any rounding left over
+		while (curr->next != NULL && pick >= sigma[curr->v]) {
+			pick -= sigma[curr->v];
+			curr = curr->next;
+		}
+		w = curr->v;
+		if (w != ws->src) {
+			hits[w] += 1;
+		}
+	}
+}
@@ -0,0 +1,115 @@
+// Approximate Centrality Measures API
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Estimates of the centrality measures for graphs too big for the exact
+// all-sources versions: betweenness by sampling shortest paths, closeness
+// by HyperLogLog counters. Runs are reproducible: the same graph, options
+// and seed give the same values.
+
+#ifndef APPROX_CENTRALITY_H
+#define APPROX_CENTRALITY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "CentralityMeasures.h"
+#include "Graph.h"
+#include "GraphCSR.h"
+
+typedef struct ApproxOptions {
+	double epsilon;     // largest error allowed in each value (see below)
+	double delta;       // chance that some value is further off than that
+	double timeBudget;  // seconds to stop sampling after, or 0 for no limit
+	uint64_t seed;
+} ApproxOptions;
+
+typedef struct ApproxReport {
+	int samplesPlanned; // samples needed for the epsilon/delta guarantee
+	int samplesTaken;   // fewer than planned if the time budget ran out
+	double seconds;
+} ApproxReport;
+
+typedef struct BetweennessComparison {
+	double maxError;    // largest |estimate - exact| over the vertices,
+	double meanError;   // and the mean, both divided by n(n - 1)
+	int outsideEpsilon; // vertices whose error is more than epsilon
+	double exactSeconds;
+	double approxSeconds;
+	ApproxReport report;
+} BetweennessComparison;
+
+/**
+ * Returns the default options: epsilon 0.01, delta 0.1, no time budget
+ * and seed 1.
+ */
+ApproxOptions approxDefaultOptions(void);
+
+/**
+ * Returns the number of (src, dest) samples betweenness estimation needs
+ * for a graph with numNodes vertices to meet the given epsilon and delta.
+ */
+int betweennessSampleSize(int numNodes, double epsilon, double delta);
+
+/**
+ * Estimates betweennessCentrality by sampling (src, dest) pairs and one
+ * shortest path between each (Riondato and Kornaropoulos). The values are
+ * on the same scale as betweennessCentrality; with probability at least
+ * 1 - delta, every value divided by n(n - 1) is within epsilon of the
+ * exact value divided by n(n - 1). If the time budget runs out first,
+ * the values are scaled from the samples taken and the guarantee does
+ * not hold. `report` may be NULL.
+ */
+NodeValues betweennessCentralityApprox(Graph g, ApproxOptions opts,
+                                       ApproxReport *report);
+
+/**
+ * Same as betweennessCentralityApprox, reading the edges from a snapshot.
+ */
+NodeValues betweennessCentralityApproxCSR(GraphCSR csr, ApproxOptions opts,
+                                          ApproxReport *report);
+
+/**
+ * Estimates betweennessCentralityNormalised in the same way. Each value
+ * is within epsilon * n / (n - 2) of the exact one, with probability at
+ * least 1 - delta.
+ */
+NodeValues betweennessCentralityNormalisedApprox(Graph g, ApproxOptions opts,
+                                                 ApproxReport *report);
+
+/**
+ * Returns the number of register bits (log2 of the registers per vertex)
+ * closenessCentralityHyperBall needs for a relative standard error of
+ * about epsilon in each count, between 4 and 16.
+ */
+int hyperBallRegisterBits(double epsilon);
+
+/**
+ * Estimates closenessCentrality without a dijkstra per vertex (HyperBall).
+ * Each vertex keeps a HyperLogLog counter of 2^registerBits registers
+ * for the set of vertices within distance t of it, for t = 0, 1, 2, ...;
+ * the counters at distance t are unions of the out neighbours' counters
+ * at distance t - weight. The reachable count and the distance sum come
+ * from how the estimated sizes grow with t. Each estimated size is off by
+ * about 1.04 / sqrt(2^registerBits) of itself.
+ *
+ * Edge weights are divided by their greatest common divisor W, and the
+ * counters of the last (maxWeight / W) distances are kept, so this uses
+ * about (maxWeight / W + 1) * n * 2^registerBits bytes and is meant for
+ * unit or small integer weights. The seed picks the hash function.
+ */
+NodeValues closenessCentralityHyperBall(Graph g, int registerBits,
+                                        uint64_t seed);
+
+/**
+ * Same as closenessCentralityHyperBall, reading the edges from a snapshot.
+ */
+NodeValues closenessCentralityHyperBallCSR(GraphCSR csr, int registerBits,
+                                           uint64_t seed);
+
+/**
+ * Runs both betweennessCentrality and betweennessCentralityApprox on the
+ * given (small) graph and reports how far apart they are.
+ */
+BetweennessComparison betweennessCompareApprox(Graph g, ApproxOptions opts);
+
+#endif
@@ -0,0 +1,180 @@
+// Centrality engine implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Brandes-style betweenness: one shortest path pass per source, path counts
+// (sigma) pushed forward in increasing distance order and dependencies
+// (delta) pulled back in decreasing distance order. This replaces walking
+// the predecessor lists once per (src, dest, v) triple.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CentralityEngine.h"
+#include "Dijkstra.h"
+#include "DijkstraWorkspace.h"
+
+struct SettledNode {
+	int dist;
+	Vertex v;
+};
+
+struct BrandesScratch {
+	int numNodes;
+	struct SettledNode *order; // reachable vertices sorted by distance
+	double *sigma;             // number of shortest paths from the source
+	double *delta;             // dependency of the source on each vertex
+};
+
+//***********************FUNCTION DECLARATIONS**********************************
+static int settle_order(const void *a, const void *b);
+static double closeness_formula(double dist_sum, int N, int n);
+//******************************************************************************
+
+BrandesScratch brandesScratchNew(int numNodes) {
+	BrandesScratch bs = malloc(sizeof(*bs));
+	assert(bs != NULL);
+	bs->numNodes = numNodes;
+	bs->order = malloc(numNodes * sizeof(struct SettledNode));
+	bs->sigma = malloc(numNodes * sizeof(double));
+	bs->delta = malloc(numNodes * sizeof(double));
+	assert(bs->order != NULL && bs->sigma != NULL && bs->delta != NULL);
+	return bs;
+}
+
+void brandesScratchFree(BrandesScratch bs) {
+	free(bs->order);
+	free(bs->sigma);
+	free(bs->delta);
+	free(bs);
+}
+
+void brandesAccumulate(ShortestPaths sps, BrandesScratch bs, double *values) {
+	// collect the reachable vertices; with positive weights every
+	// predecessor is strictly closer to the source than its successor, so
+	// sorting by distance recovers a valid settle order
+	int reached = 0;
+	for (int v = 0; v < sps.numNodes; v++) {
+		bs->sigma[v] = 0;
+		bs->delta[v] = 0;
+		if (sps.dist[v] != INFINITY) {
+			bs->order[reached].dist = sps.dist[v];
+			bs->order[reached].v = v;
+			reached++;
+		}
+	}
+	qsort(bs->order, reached, sizeof(struct SettledNode), settle_order);
+
+	// count shortest paths from the source to each vertex
+	bs->sigma[sps.src] = 1;
+	for (int i = 0; i < reached; i++) {
+		Vertex w = bs->order[i].v;
+		for (PredNode *curr = sps.pred[w]; curr != NULL; curr = curr->next) {
+			bs->sigma[w] += bs->sigma[curr->v];
+		}
+	}
+
+	// accumulate dependencies, furthest vertices first
+	for (int i = reached - 1; i >= 0; i--) {
+		Vertex w = bs->order[i].v;
+		for (PredNode *curr = sps.pred[w]; curr != NULL; curr = curr->next) {
+			double share = bs->sigma[curr->v] / bs->sigma[w];
+			bs->delta[curr->v] += share * (1 + bs->delta[w]);
+		}
+		if (w != sps.src) {
+			values[w] += bs->delta[w];
+		}
+	}
+}
+
+void brandesAccumulateWorkspace(DijkstraWorkspace ws, BrandesScratch bs,
+                                double *values) {
+	// the run settled the reached vertices in distance order already, and
+	// every predecessor of a reached vertex was reached too
+	for (int i = 0; i < ws->numSettled; i++) {
+		bs->sigma[ws->settled[i]] = 0;
+		bs->delta[ws->settled[i]] = 0;
+	}
+
+	bs->sigma[ws->src] = 1;
+	for (int i = 0; i < ws->numSettled; i++) {
+		Vertex w = ws->settled[i];
+		for (PredNode *curr = ws->pred[w]; curr != NULL; curr = curr->next) {
+			bs->sigma[w] += bs->sigma[curr->v];
+		}
+	}
+
+	for (int i = ws->numSettled - 1; i >= 0; i--) {
+		Vertex w = ws->settled[i];
+		for (PredNode *curr = ws->pred[w]; curr != NULL; curr = curr->next) {
+			double share = bs->sigma[curr->v] / bs->sigma[w];
+			bs->delta[curr->v] += share * (1 + bs->delta[w]);
+		}
+		if (w != ws->src) {
+			values[w] += bs->delta[w];
+		}
+	}
+}
+
+// orders settled vertices by distance, then by vertex number
+static int settle_order(const void *a, const void *b) {
+	const struct SettledNode *node_1 = a;
+	const struct SettledNode *node_2 = b;
+	if (node_1->dist != node_2->dist) {
+		return node_1->dist < node_2->dist ? -1 : 1;
+	}
+	return node_1->v - node_2->v;
+}
+
+double betweennessNormalise(int numNodes, double value) {
+	int n = numNodes;
+	double result = 1.0*1/(n - 1)*1/(n-2);
+	result = result*value;
+	return result;
+}
+
+double closenessFromPaths(ShortestPaths sps) {
+	double dist_sum = 0;
+	int reachable_num = 0;
+	// loop through all vertices in graph
+	for (int j = 0; j < sps.numNodes; j++) {
+		// runs if vertex j is reachable from the source
+		if (sps.dist[j] != 0 && sps.dist[j] != INFINITY) {
+			dist_sum += sps.dist[j];
+			reachable_num++;
+		}
+	}
+	// node counts itself as a reachable node
+	reachable_num++;
+	// if node is not reachable, closeness value is 0
+	if (dist_sum == 0) {
+		return 0;
+	}
+	return closeness_formula(dist_sum, sps.numNodes, reachable_num);
+}
+
+double closenessFromWorkspace(DijkstraWorkspace ws) {
+	double dist_sum = 0;
+	// every settled vertex other than the source is at a positive distance
+	for (int i = 0; i < ws->numSettled; i++) {
+		dist_sum += dijkstraWorkspaceDist(ws, ws->settled[i]);
+	}
+	if (dist_sum == 0) {
+		return 0;
+	}
+	return closeness_formula(dist_sum, ws->numNodes, ws->numSettled);
+}
+
+double closenessFromSums(double distSum, int numNodes, double reachable) {
+	if (distSum <= 0) {
+		return 0;
+	}
+	double result = (reachable - 1) * (reachable - 1) / (numNodes - 1);
+	return result / distSum;
+}
+
+// formula to return the closeness centrality for a node given amount of
+// reachable nodes and total min distance
+static double closeness_formula(double dist_sum, int N, int n) {
+	return closenessFromSums(dist_sum, N, n);
+}
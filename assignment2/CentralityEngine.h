@@ -0,0 +1,65 @@
+// Centrality engine interface
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Per-source kernels shared by the centrality measures. Each kernel takes
+// the shortest paths from one source and folds them into a result, so the
+// callers only ever need one dijkstra() run per source vertex.
+
+#ifndef CENTRALITY_ENGINE_H
+#define CENTRALITY_ENGINE_H
+
+#include "Dijkstra.h"
+#include "DijkstraWorkspace.h"
+
+typedef struct BrandesScratch *BrandesScratch;
+
+/**
+ * Creates  the  scratch buffers (settle order, path counts, dependencies)
+ * needed to accumulate betweenness for a graph with numNodes vertices.
+ */
+BrandesScratch brandesScratchNew(int numNodes);
+
+/**
+ * Frees the given scratch buffers.
+ */
+void brandesScratchFree(BrandesScratch bs);
+
+/**
+ * Adds  the  dependencies  of the source of `sps` on every other vertex
+ * into `values`. Summing this over every source gives the betweenness
+ * centrality. Assumes all edge weights are positive.
+ */
+void brandesAccumulate(ShortestPaths sps, BrandesScratch bs, double *values);
+
+/**
+ * Same as brandesAccumulate(), for the last run in a Dijkstra workspace.
+ * Only looks at the vertices that run reached.
+ */
+void brandesAccumulateWorkspace(DijkstraWorkspace ws, BrandesScratch bs,
+                                double *values);
+
+/**
+ * Returns  the  normalised  form  of  a betweenness value for a graph with
+ * numNodes vertices.
+ */
+double betweennessNormalise(int numNodes, double value);
+
+/**
+ * Returns  the  closeness  centrality of the source vertex of `sps`.
+ */
+double closenessFromPaths(ShortestPaths sps);
+
+/**
+ * Returns  the  closeness  centrality of the source of the last run in a
+ * Dijkstra workspace.
+ */
+double closenessFromWorkspace(DijkstraWorkspace ws);
+
+/**
+ * Returns  the  closeness centrality of a vertex that reaches `reachable`
+ * vertices (counting itself) at a total distance of `distSum`, in a graph
+ * with numNodes vertices. The counts may be estimates.
+ */
+double closenessFromSums(double distSum, int numNodes, double reachable);
+
+#endif
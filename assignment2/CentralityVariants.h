@@ -0,0 +1,30 @@
+// Centrality Measures API extensions
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Versions of the centrality measures that read a prebuilt graph snapshot.
+// The Graph versions in CentralityMeasures.h build a snapshot once and
+// call these.
+
+#ifndef CENTRALITY_VARIANTS_H
+#define CENTRALITY_VARIANTS_H
+
+#include "CentralityMeasures.h"
+#include "GraphCSR.h"
+
+/**
+ * Same as closenessCentrality, reading the edges from a snapshot.
+ */
+NodeValues closenessCentralityCSR(GraphCSR csr);
+
+/**
+ * Same as betweennessCentrality, reading the edges from a snapshot.
+ */
+NodeValues betweennessCentralityCSR(GraphCSR csr);
+
+/**
+ * Same  as  betweennessCentralityNormalised, reading the edges from a
+ * snapshot.
+ */
+NodeValues betweennessCentralityNormalisedCSR(GraphCSR csr);
+
+#endif
@@ -0,0 +1,288 @@
+// Top-k closeness centrality implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Pruned all-sources search in the style of Bergamini et al. Sources are
+// run one at a time, a step of dijkstra at a time, while the k best found
+// so far are kept. After each step the closeness the source could still
+// reach is bounded from the partial results:
+//   - vertices settled so far: s of them, at a total distance of S;
+//   - every vertex settled later is at least d away, d being the next
+//     distance in the queue;
+//   - the source reaches r vertices, at least the t it has touched and at
+//     most R, a bound from the strongly connected components.
+// So the closeness is at most (r - 1)^2 / ((n - 1)(S + (r - s)d)) for some r
+// in [t, R]. Over that range the expression falls and then rises, so its
+// largest value is at one of the ends. Once that bound can't beat the k-th
+// best, the search from this source stops.
+//
+// The bound is computed with the same formula (and the same floating point
+// operations) as the exact value, so a source is only dropped when its
+// exact value could not rank in the top k either.
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CentralityEngine.h"
+#include "ClosenessTopK.h"
+#include "Dijkstra.h"
+#include "DijkstraWorkspace.h"
+#include "GraphCSR.h"
+
+struct Candidate {
+	int reach;     // upper bound on the vertices the source reaches
+	int degree;
+	Vertex v;
+};
+
+struct TopList {
+	int k;
+	int size;
+	RankedNode *nodes;     // best first
+};
+
+//***********************FUNCTION DECLARATIONS**********************************
+static int *reach_bounds(GraphCSR csr);
+static int candidate_order(const void *a, const void *b);
+static bool ranks_before(double value_a, Vertex a, double value_b, Vertex b);
+static bool top_cannot_enter(struct TopList *top, double bound, Vertex v);
+static void top_offer(struct TopList *top, Vertex v, double value);
+static double closeness_bound(DijkstraWorkspace ws, double dist_sum,
+                              int reach_bound);
+//******************************************************************************
+
+int closenessTopK(Graph g, int k, RankedNode *top) {
+	GraphCSR csr = GraphCSRNewOut(g);
+	int stored = closenessTopKCSR(csr, k, top);
+	GraphCSRFree(csr);
+	return stored;
+}
+
+int closenessTopKCSR(GraphCSR csr, int k, RankedNode *top) {
+	int n = csr->numNodes;
+	if (k <= 0 || n <= 0) {
+		return 0;
+	}
+	struct TopList best = { k, 0, top };
+
+	// try the sources likely to be central first, so the k-th best value
+	// rises quickly and prunes the rest
+	int *reach = reach_bounds(csr);
+	struct Candidate *order = malloc(n * sizeof(struct Candidate));
+	assert(order != NULL);
+	for (Vertex v = 0; v < n; v++) {
+		order[v].reach = reach[v];
+		order[v].degree = csr->outOffset[v + 1] - csr->outOffset[v];
+		order[v].v = v;
+	}
+	qsort(order, n, sizeof(struct Candidate), candidate_order);
+
+	DijkstraWorkspace ws = dijkstraWorkspaceNew(n);
+	for (int i = 0; i < n; i++) {
+		Vertex src = order[i].v;
+		double dist_sum = 0;
+		bool pruned = false;
+		dijkstraStepStart(csr, src, ws);
+		Vertex settled;
+		while ((settled = dijkstraStep(ws)) != NO_VERTEX) {
+			dist_sum += dijkstraWorkspaceDist(ws, settled);
+			double bound = closeness_bound(ws, dist_sum, order[i].reach);
+			if (top_cannot_enter(&best, bound, src)) {
+				dijkstraStepStop(ws);
+				pruned = true;
+				break;
+			}
+		}
+		if (!pruned) {
+			top_offer(&best, src, closenessFromWorkspace(ws));
+		}
+	}
+
+	dijkstraWorkspaceFree(ws);
+	free(order);
+	free(reach);
+	return best.size;
+}
+
+//******************************HELPER FUNCTIONS********************************
+
+// returns, for each vertex, an upper bound on how many vertices it reaches
+// (itself included). Tarjan's algorithm (without recursion) finds the
+// strongly connected components in reverse topological order, so each
+// component's bound - its size plus the bounds of the components it has
+// edges to - only needs components already done. Paths through several
+// components are counted more than once, so the bound is capped at n.
+static int *reach_bounds(GraphCSR csr) {
+	int n = csr->numNodes;
+	int *index = malloc(n * sizeof(int));
+	int *low = malloc(n * sizeof(int));
+	int *next_edge = malloc(n * sizeof(int));
+	bool *on_stack = calloc(n, sizeof(bool));
+	Vertex *stack = malloc(n * sizeof(Vertex));     // Tarjan's stack
+	Vertex *calls = malloc(n * sizeof(Vertex));     // the depth first path
+	int *component = malloc(n * sizeof(int));
+	Vertex *members = malloc(n * sizeof(Vertex));   // grouped by component
+	int *first_member = malloc((n + 1) * sizeof(int));
+	assert(index != NULL && low != NULL && next_edge != NULL);
+	assert(on_stack != NULL && stack != NULL && calls != NULL);
+	assert(component != NULL && members != NULL && first_member != NULL);
+
+	for (Vertex v = 0; v < n; v++) {
+		index[v] = -1;
+	}
+	int counter = 0;
+	int stack_size = 0;
+	int num_members = 0;
+	int num_components = 0;
+	for (Vertex root = 0; root < n; root++) {
+		if (index[root] != -1) continue;
+		int depth = 0;
+		calls[depth++] = root;
+		index[root] = low[root] = counter++;
+		next_edge[root] = csr->outOffset[root];
+		stack[stack_size++] = root;
+		on_stack[root] = true;
+
+		while (depth > 0) {
+			Vertex v = calls[depth - 1];
+			if (next_edge[v] < csr->outOffset[v + 1]) {
+				Vertex w = csr->outVertex[next_edge[v]++];
+				if (index[w] == -1) {
+					index[w] = low[w] = counter++;
+					next_edge[w] = csr->outOffset[w];
+					stack[stack_size++] = w;
+					on_stack[w] = true;
+					calls[depth++] = w;
+				}
+				else if (on_stack[w] && index[w] < low[v]) {
+					low[v] = index[w];
+				}
+				continue;
+			}
+			// every edge of v is done
+			depth--;
+			if (depth > 0 && low[v] < low[calls[depth - 1]]) {
+				low[calls[depth - 1]] = low[v];
+			}
+			if (low[v] == index[v]) {
+				// v is the root of a component; pop it off the stack
+				first_member[num_components] = num_members;
+				Vertex w;
+				do {
+					w = stack[--stack_size];
+					on_stack[w] = false;
+					component[w] = num_components;
+					members[num_members++] = w;
+				} while (w != v);
+				num_components++;
+			}
+		}
+	}
+	first_member[num_components] = num_members;
+
+	// `seen` marks the components already added to the current one's bound
+	long *bound = malloc(num_components * sizeof(long));
+	int *seen = malloc(num_components * sizeof(int));
+	assert(bound != NULL && seen != NULL);
+	for (int c = 0; c < num_components; c++) {
+		seen[c] = -1;
+	}
+	for (int c = 0; c < num_components; c++) {
+		bound[c] = first_member[c + 1] - first_member[c];
+		for (int m = first_member[c]; m < first_member[c + 1]; m++) {
+			Vertex v = members[m];
+			for (int e = csr->outOffset[v]; e < csr->outOffset[v + 1]; e++) {
+				int other = component[csr->outVertex[e]];
+				if (other != c && seen[other] != c) {
+					seen[other] = c;
+					bound[c] += bound[other];
+				}
+			}
+		}
+		if (bound[c] > n) bound[c] = n;
+	}
+
+	// reuse `index` for the result
+	int *reach = index;
+	for (Vertex v = 0; v < n; v++) {
+		reach[v] = (int)bound[component[v]];
+	}
+	free(low);
+	free(next_edge);
+	free(on_stack);
+	free(stack);
+	free(calls);
+	free(component);
+	free(members);
+	free(first_member);
+	free(bound);
+	free(seen);
+	return reach;
+}
+
+// orders candidate sources by reach bound, then by out degree (both
+// largest first), then by vertex
+static int candidate_order(const void *a, const void *b) {
+	const struct Candidate *cand_1 = a;
+	const struct Candidate *cand_2 = b;
+	if (cand_1->reach != cand_2->reach) {
+		return cand_1->reach > cand_2->reach ? -1 : 1;
+	}
+	if (cand_1->degree != cand_2->degree) {
+		return cand_1->degree > cand_2->degree ? -1 : 1;
+	}
+	return cand_1->v - cand_2->v;
+}
+
+// returns true if vertex a (with value_a) ranks ahead of vertex b
+static bool ranks_before(double value_a, Vertex a, double value_b, Vertex b) {
+	if (value_a != value_b) {
+		return value_a > value_b;
+	}
+	return a < b;
+}
+
+// returns true if v can't enter a full top list even with closeness `bound`
+static bool top_cannot_enter(struct TopList *top, double bound, Vertex v) {
+	if (top->size < top->k) {
+		return false;
+	}
+	RankedNode *last = &top->nodes[top->k - 1];
+	return !ranks_before(bound, v, last->value, last->v);
+}
+
+// inserts v into the top list if it ranks high enough
+static void top_offer(struct TopList *top, Vertex v, double value) {
+	if (top_cannot_enter(top, value, v)) {
+		return;
+	}
+	int i = top->size < top->k ? top->size++ : top->k - 1;
+	// shift the worse entries down one place
+	while (i > 0 && ranks_before(value, v, top->nodes[i - 1].value,
+	                             top->nodes[i - 1].v)) {
+		top->nodes[i] = top->nodes[i - 1];
+		i--;
+	}
+	top->nodes[i].v = v;
+	top->nodes[i].value = value;
+}
+
+// the largest closeness the source of the run in progress could still have
+// (see the top of the file)
+static double closeness_bound(DijkstraWorkspace ws, double dist_sum,
+                              int reach_bound) {
+	int settled = ws->numSettled;
+	int touched = ws->numTouched;
+	int next = dijkstraStepNextDist(ws);
+	if (next == INFINITY) {
+		// the run is over, so this is the exact value
+		return closenessFromSums(dist_sum, ws->numNodes, settled);
+	}
+	if (reach_bound < touched) reach_bound = touched;
+	double fewest = closenessFromSums(dist_sum + (double)(touched - settled) * next,
+	                                  ws->numNodes, touched);
+	double most = closenessFromSums(dist_sum + (double)(reach_bound - settled) * next,
+	                                ws->numNodes, reach_bound);
+	return fewest > most ? fewest : most;
+}
@@ -0,0 +1,32 @@
+// Top-k closeness centrality interface
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Finds only the most central vertices, which is usually far less work than
+// finding the closeness of every vertex.
+
+#ifndef CLOSENESS_TOP_K_H
+#define CLOSENESS_TOP_K_H
+
+#include "Graph.h"
+#include "GraphCSR.h"
+
+typedef struct RankedNode {
+	Vertex v;
+	double value;
+} RankedNode;
+
+/**
+ * Finds  the  `k`  vertices with the highest closeness centrality and
+ * stores them in the given `top` array (of size k) in decreasing order of
+ * closeness, and then in increasing order of vertex for equal closeness.
+ * The vertices and values are exactly the first k of closenessCentrality's
+ * values ranked that way. Returns the number stored, min(k, #vertices).
+ */
+int closenessTopK(Graph g, int k, RankedNode *top);
+
+/**
+ * Same as closenessTopK, reading the edges from a snapshot.
+ */
+int closenessTopKCSR(GraphCSR csr, int k, RankedNode *top);
+
+#endif
@@ -12,104 +12,125 @@
 #include <stdlib.h>
 
 #include "Dijkstra.h"
+#include "DijkstraVariants.h"
+#include "DijkstraWorkspace.h"
 #include "Graph.h"
-#include "PQ.h"
+#include "GraphCSR.h"
+#include "IndexedPQ.h"
+#include "PredArena.h"
 
 //******************************FUNCTION DECLARATIONS***************************
-static PredNode *create_prednode(Vertex v);
-static void free_predlist(PredNode *pred);
+static ShortestPaths dijkstra_csr(GraphCSR csr, Vertex src, IPQKind kind);
 //******************************************************************************
 
 ShortestPaths dijkstra(Graph g, Vertex src) {
+	return dijkstraWithQueue(g, src, IPQDefaultKind());
+}
+
+ShortestPaths dijkstraWithQueue(Graph g, Vertex src, IPQKind kind) {
+	// dijkstra only follows out edges
+	GraphCSR csr = GraphCSRNewOut(g);
+	ShortestPaths sps = dijkstra_csr(csr, src, kind);
+	GraphCSRFree(csr);
+	return sps;
+}
+
+ShortestPaths dijkstraCSR(GraphCSR csr, Vertex src) {
+	return dijkstra_csr(csr, src, IPQDefaultKind());
+}
+
+ShortestPaths dijkstraCSRWithQueue(GraphCSR csr, Vertex src, IPQKind kind) {
+	return dijkstra_csr(csr, src, kind);
+}
+
+ShortestPaths dijkstraTo(Graph g, Vertex src, Vertex dest) {
+	DijkstraWorkspace ws = dijkstraWorkspaceNew(GraphNumVertices(g));
+	dijkstraToInto(g, src, dest, ws);
+	ShortestPaths sps = dijkstraWorkspacePaths(ws);
+	dijkstraWorkspaceFree(ws);
+	return sps;
+}
+
+ShortestPaths dijkstraToCSR(GraphCSR csr, Vertex src, Vertex dest) {
+	DijkstraWorkspace ws = dijkstraWorkspaceNew(csr->numNodes);
+	dijkstraCSRToInto(csr, src, dest, ws);
+	ShortestPaths sps = dijkstraWorkspacePaths(ws);
+	dijkstraWorkspaceFree(ws);
+	return sps;
+}
+
+ShortestPaths dijkstraWithin(Graph g, Vertex src, int radius) {
+	DijkstraWorkspace ws = dijkstraWorkspaceNew(GraphNumVertices(g));
+	dijkstraWithinInto(g, src, radius, ws);
+	ShortestPaths sps = dijkstraWorkspacePaths(ws);
+	dijkstraWorkspaceFree(ws);
+	return sps;
+}
+
+ShortestPaths dijkstraWithinCSR(GraphCSR csr, Vertex src, int radius) {
+	DijkstraWorkspace ws = dijkstraWorkspaceNew(csr->numNodes);
+	dijkstraCSRWithinInto(csr, src, radius, ws);
+	ShortestPaths sps = dijkstraWorkspacePaths(ws);
+	dijkstraWorkspaceFree(ws);
+	return sps;
+}
+
+// runs dijkstra over the contiguous out edges of a graph snapshot
+static ShortestPaths dijkstra_csr(GraphCSR csr, Vertex src, IPQKind kind) {
 	ShortestPaths sps;
-	sps.numNodes = GraphNumVertices(g); 
+	sps.numNodes = csr->numNodes;
 	sps.src = src;
 	// dynamically allocate dist array based on number of vertices
 	sps.dist = malloc(sps.numNodes * sizeof(int));
-	// dynamically allocate pred array of linked lists based on number of vertices
-	sps.pred = malloc(sps.numNodes * sizeof(struct PredNode));
-	PQ v_set = PQNew();
+	// allocate pred array of linked lists, backed by a PredNode arena
+	sps.pred = predArrayNew(sps.numNodes);
+	// the bucket queue needs to know how far apart queued keys can be
+	IPQ v_set = IPQNew(sps.numNodes, kind, csr->maxWeight);
 
-	//set all values in pred array to NULL and all values in dist array to
-	//INFINITY
-	for (int i = 0; i < GraphNumVertices(g); i++) {
+	//set all values in dist array to INFINITY
+	for (int i = 0; i < sps.numNodes; i++) {
 		sps.dist[i] = INFINITY;
-		sps.pred[i] = NULL;
 	}
 	sps.dist[src] = 0;
 	// queue the source vertex
-	PQInsert(v_set, src, 0);
+	IPQInsert(v_set, src, 0);
 
-	// runs while the priority queue is not empty
-	while (!PQIsEmpty(v_set)) {
-		int vertex = PQDequeue(v_set);
-		// create adjacency list representation of outlinks from dequeued vertex
-		AdjList out = GraphOutIncident(g, vertex);
+	// runs while the priority queue is not empty; every vertex is dequeued
+	// once, with its final distance
+	while (!IPQIsEmpty(v_set)) {
+		int vertex = IPQDequeue(v_set);
 
-		// loop through AdjList of out edges from the vertex
-		while (out != NULL) {
+		// loop through the out edges from the dequeued vertex
+		for (int e = csr->outOffset[vertex]; e < csr->outOffset[vertex + 1]; e++) {
+			Vertex w = csr->outVertex[e];
+			int new_dist = sps.dist[vertex] + csr->outWeight[e];
 			// perform edge relaxation (update arrays if we find a new min path)
-			if (sps.dist[vertex] + out->weight < sps.dist[out->v]) {
-				// clear the pred_nodes list (as they are not the minimum cost)
-				if (sps.pred[out->v] != NULL) {
-					free_predlist(sps.pred[out->v]);
-				}
+			if (new_dist < sps.dist[w]) {
 				// update dist to the new minimum distance
-				sps.dist[out->v] = sps.dist[vertex] + out->weight;
-				// add the current dequeued vertex to the predecessor list of the
-				// current "out" vertex
-				sps.pred[out->v] = create_prednode(vertex);
-				PQInsert(v_set, out->v, out->weight);
+				sps.dist[w] = new_dist;
+				// replace the pred_nodes list (as they are not the minimum cost)
+				// with the current dequeued vertex
+				predArraySet(sps.pred, w, vertex);
+				// queue the vertex, or lower its key if it is already queued
+				IPQInsert(v_set, w, new_dist);
 			}
 			// if we have found a different path of the same minimum distance
-			else if (sps.dist[vertex] + out->weight == sps.dist[out->v]) {
+			else if (new_dist == sps.dist[w]) {
 				// add new path to the head of the adjacency list of predecessors
-				PredNode *curr = sps.pred[out->v];
-				PredNode *new_head = create_prednode(vertex);
-				// link new node to the head
-				new_head->next = curr;
-				// replace head with new node
-				sps.pred[out->v] = new_head;
+				predArrayPush(sps.pred, w, vertex);
 			}
-			out = out->next;
 		}
 	}
-	PQFree(v_set);
+	IPQFree(v_set);
 	return sps;
 }
 
-// helper function to return a newly malloc'd PredNode
-static PredNode *create_prednode(Vertex v) {
-	PredNode *new_node = malloc(sizeof(struct PredNode));
-	new_node->v = v;
-	new_node->next = NULL;
-	return new_node;
-}
-
-// helper function to free a PredNodes linked list
-static void free_predlist(PredNode *pred) {
-	PredNode *temp;
-	// iterate through list
-	while (pred != NULL) {
-		temp = pred;
-		pred = pred->next;
-		free(temp);
-	}
-}
-
 // frees all memory associated with the given ShortestPaths structure.
 void freeShortestPaths(ShortestPaths sps) {
 	// free dist array
 	free(sps.dist);
-	int i = 0;
-	// iterate through array of linked list and free all linked lists
-	while (i < sps.numNodes) {
-		PredNode *temp = sps.pred[i];
-		free_predlist(temp);
-		i++;
-	}
-	// free the array of linked lists
-	free(sps.pred);
+	// free the array of linked lists along with every PredNode in it
+	predArrayFree(sps.pred);
 }
 
 
@@ -0,0 +1,68 @@
+// Dijkstra API extensions
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Extra entry points to the shortest path code in Dijkstra.c. They return
+// the same ShortestPaths structure as dijkstra(), to be released with
+// freeShortestPaths().
+
+#ifndef DIJKSTRA_VARIANTS_H
+#define DIJKSTRA_VARIANTS_H
+
+#include "Dijkstra.h"
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "IndexedPQ.h"
+
+/**
+ * Same as dijkstra(), using the given kind of priority queue. dijkstra()
+ * itself uses IPQDefaultKind(), so the queue can also be picked with the
+ * DIJKSTRA_QUEUE environment variable.
+ */
+ShortestPaths dijkstraWithQueue(Graph g, Vertex src, IPQKind kind);
+
+/**
+ * Same as dijkstra(), reading the edges from a graph snapshot. Use this
+ * when running many sources over the same graph; dijkstra() has to build
+ * a snapshot on every call.
+ */
+ShortestPaths dijkstraCSR(GraphCSR csr, Vertex src);
+
+/**
+ * Same as dijkstraCSR(), using the given kind of priority queue.
+ */
+ShortestPaths dijkstraCSRWithQueue(GraphCSR csr, Vertex src, IPQKind kind);
+
+/**
+ * Finds  all  shortest  paths  from src to dest only. The length is found
+ * by searching forwards from src and backwards from dest at once, and a
+ * second forward search then only follows edges that can still be on a
+ * path of that length. src, dest and every vertex on a shortest path
+ * between them have the same dist and pred as in dijkstra(g, src) (with
+ * the binary heap, the pred lists are even in the same order); every other
+ * vertex has a dist of INFINITY and an empty pred list, as does dest if it
+ * can't be reached. The result alone takes time proportional to the size
+ * of the graph, so repeated queries should hold a workspace and call
+ * dijkstraToInto() (see DijkstraWorkspace.h) instead.
+ */
+ShortestPaths dijkstraTo(Graph g, Vertex src, Vertex dest);
+
+/**
+ * Same as dijkstraTo(), reading the edges from a graph snapshot.
+ */
+ShortestPaths dijkstraToCSR(GraphCSR csr, Vertex src, Vertex dest);
+
+/**
+ * Finds the shortest paths from src to the vertices at most `radius` (>= 0)
+ * away, stopping as soon as the next closest vertex is further than that.
+ * Those vertices have the same dist and pred as in dijkstra(g, src); every
+ * other vertex has a dist of INFINITY and an empty pred list. Repeated
+ * queries should hold a workspace and call dijkstraWithinInto() instead.
+ */
+ShortestPaths dijkstraWithin(Graph g, Vertex src, int radius);
+
+/**
+ * Same as dijkstraWithin(), reading the edges from a graph snapshot.
+ */
+ShortestPaths dijkstraWithinCSR(GraphCSR csr, Vertex src, int radius);
+
+#endif
@@ -0,0 +1,560 @@
+// Reusable Dijkstra workspace implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+// The run counter is bumped at the start of every run; when it wraps
+// around, the stamps are cleared once so an entry from 2^32 runs ago can't
+// be mistaken for a current one. The queue is left empty after every run
+// (a run that stops at its target clears it), so it is reused as is; a
+// bucket queue only grows when it meets heavier edges than it was made for.
+// Runs over a Graph find those edges as they go, so they grow the queue in
+// the middle of the run.
+//
+// Point-to-point queries also search backwards from the target. That
+// search has its own stamped distances, run counter and queue, which are
+// only allocated by the first such query.
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Dijkstra.h"
+#include "DijkstraWorkspace.h"
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "IndexedPQ.h"
+#include "PredArena.h"
+
+// walks the out (or in) edges of one vertex, from a graph snapshot or
+// straight from the graph's adjacency lists
+struct EdgeCursor {
+	const Vertex *vertex;     // snapshot edges
+	const int *weight;
+	int e;
+	int end;
+	AdjList curr;             // adjacency list edges
+};
+
+//***********************FUNCTION DECLARATIONS**********************************
+static void start_run(DijkstraWorkspace ws, Vertex src, GraphCSR csr,
+                      Graph g);
+static void begin_run(DijkstraWorkspace ws, Vertex src, int maxWeight);
+static void reserve_weight(DijkstraWorkspace ws, int maxWeight);
+static void edges_start(struct EdgeCursor *edges, DijkstraWorkspace ws,
+                        Vertex v, bool in);
+static bool edges_next(struct EdgeCursor *edges, DijkstraWorkspace ws,
+                       Vertex *w, int *weight);
+static void relax(DijkstraWorkspace ws, Vertex vertex, Vertex w, int weight);
+static void set_dist(DijkstraWorkspace ws, Vertex v, int dist);
+static void settle_within(DijkstraWorkspace ws, int radius);
+static void forget(DijkstraWorkspace ws, Vertex v);
+static void paths_to(DijkstraWorkspace ws, Vertex src, Vertex dest);
+static int meeting_distance(DijkstraWorkspace ws, Vertex src, Vertex dest,
+                            int *backward_top);
+static void paths_between(DijkstraWorkspace ws, Vertex src, int mu,
+                          int backward_top);
+static void keep_paths_to(DijkstraWorkspace ws, Vertex dest);
+static void begin_backward(DijkstraWorkspace ws);
+static int backward_dist(DijkstraWorkspace ws, Vertex v);
+static void set_backward_dist(DijkstraWorkspace ws, Vertex v, int dist);
+//******************************************************************************
+
+DijkstraWorkspace dijkstraWorkspaceNew(int numNodes) {
+	return dijkstraWorkspaceNewWithQueue(numNodes, IPQDefaultKind());
+}
+
+DijkstraWorkspace dijkstraWorkspaceNewWithQueue(int numNodes, IPQKind kind) {
+	DijkstraWorkspace ws = malloc(sizeof(*ws));
+	assert(ws != NULL);
+	ws->numNodes = numNodes;
+	ws->src = 0;
+	ws->numSettled = 0;
+	ws->numTouched = 0;
+	ws->run = 0;
+	int size = numNodes > 0 ? numNodes : 1;
+	// calloc'd stamps all match run 0, so every distance starts at INFINITY
+	ws->stamp = calloc(size, sizeof(unsigned));
+	ws->dist = malloc(size * sizeof(int));
+	ws->settled = malloc(size * sizeof(Vertex));
+	ws->touched = malloc(size * sizeof(Vertex));
+	assert(ws->stamp != NULL && ws->dist != NULL);
+	assert(ws->settled != NULL && ws->touched != NULL);
+	for (int v = 0; v < numNodes; v++) {
+		ws->dist[v] = INFINITY;
+	}
+	ws->pred = predArrayNew(numNodes);
+	ws->kind = kind;
+	ws->csr = NULL;
+	ws->graph = NULL;
+	ws->pq = NULL;
+	ws->pqMaxWeight = 0;
+	ws->backDist = NULL;
+	ws->backStamp = NULL;
+	ws->backRun = 0;
+	ws->backPq = NULL;
+	return ws;
+}
+
+void dijkstraWorkspaceFree(DijkstraWorkspace ws) {
+	free(ws->stamp);
+	free(ws->dist);
+	free(ws->settled);
+	free(ws->touched);
+	predArrayFree(ws->pred);
+	if (ws->pq != NULL) {
+		IPQFree(ws->pq);
+	}
+	free(ws->backDist);
+	free(ws->backStamp);
+	if (ws->backPq != NULL) {
+		IPQFree(ws->backPq);
+	}
+	free(ws);
+}
+
+void dijkstraInto(Graph g, Vertex src, DijkstraWorkspace ws) {
+	assert(GraphNumVertices(g) == ws->numNodes);
+	start_run(ws, src, NULL, g);
+	// settle every reachable vertex
+	while (dijkstraStep(ws) != NO_VERTEX) {
+	}
+}
+
+void dijkstraCSRInto(GraphCSR csr, Vertex src, DijkstraWorkspace ws) {
+	dijkstraStepStart(csr, src, ws);
+	// settle every reachable vertex
+	while (dijkstraStep(ws) != NO_VERTEX) {
+	}
+}
+
+void dijkstraCSRIntoTarget(GraphCSR csr, Vertex src, Vertex dest,
+                           DijkstraWorkspace ws) {
+	assert(dest >= 0 && dest < csr->numNodes);
+	dijkstraStepStart(csr, src, ws);
+	Vertex vertex;
+	while ((vertex = dijkstraStep(ws)) != NO_VERTEX) {
+		if (vertex == dest) {
+			dijkstraStepStop(ws);
+			break;
+		}
+	}
+}
+
+void dijkstraToInto(Graph g, Vertex src, Vertex dest, DijkstraWorkspace ws) {
+	assert(GraphNumVertices(g) == ws->numNodes);
+	assert(dest >= 0 && dest < ws->numNodes);
+	ws->csr = NULL;
+	ws->graph = g;
+	paths_to(ws, src, dest);
+}
+
+void dijkstraCSRToInto(GraphCSR csr, Vertex src, Vertex dest,
+                       DijkstraWorkspace ws) {
+	assert(csr->numNodes == ws->numNodes);
+	assert(dest >= 0 && dest < ws->numNodes);
+	// the backward search needs the in edges
+	assert(csr->inOffset != NULL);
+	ws->csr = csr;
+	ws->graph = NULL;
+	paths_to(ws, src, dest);
+}
+
+void dijkstraWithinInto(Graph g, Vertex src, int radius,
+                        DijkstraWorkspace ws) {
+	assert(GraphNumVertices(g) == ws->numNodes);
+	start_run(ws, src, NULL, g);
+	settle_within(ws, radius);
+}
+
+void dijkstraCSRWithinInto(GraphCSR csr, Vertex src, int radius,
+                           DijkstraWorkspace ws) {
+	dijkstraStepStart(csr, src, ws);
+	settle_within(ws, radius);
+}
+
+ShortestPaths dijkstraWorkspacePaths(DijkstraWorkspace ws) {
+	ShortestPaths sps;
+	sps.numNodes = ws->numNodes;
+	sps.src = ws->src;
+	sps.dist = malloc(sps.numNodes * sizeof(int));
+	assert(sps.dist != NULL);
+	sps.pred = predArrayNew(sps.numNodes);
+	for (int i = 0; i < sps.numNodes; i++) {
+		sps.dist[i] = INFINITY;
+	}
+	// only the touched vertices can have a distance or predecessors
+	for (int i = 0; i < ws->numTouched; i++) {
+		Vertex v = ws->touched[i];
+		sps.dist[v] = dijkstraWorkspaceDist(ws, v);
+		if (sps.dist[v] == INFINITY) continue;
+		// pushing reverses the list, so reverse it back afterwards
+		for (PredNode *curr = ws->pred[v]; curr != NULL; curr = curr->next) {
+			predArrayPush(sps.pred, v, curr->v);
+		}
+		PredNode *reversed = NULL;
+		PredNode *curr = sps.pred[v];
+		while (curr != NULL) {
+			PredNode *next = curr->next;
+			curr->next = reversed;
+			reversed = curr;
+			curr = next;
+		}
+		sps.pred[v] = reversed;
+	}
+	return sps;
+}
+
+void dijkstraStepStart(GraphCSR csr, Vertex src, DijkstraWorkspace ws) {
+	assert(csr->numNodes == ws->numNodes);
+	start_run(ws, src, csr, NULL);
+}
+
+Vertex dijkstraStep(DijkstraWorkspace ws) {
+	if (IPQIsEmpty(ws->pq)) {
+		return NO_VERTEX;
+	}
+	// every queued vertex is dequeued once, with its final distance
+	Vertex vertex = IPQDequeue(ws->pq);
+	ws->settled[ws->numSettled++] = vertex;
+
+	GraphCSR csr = ws->csr;
+	if (csr != NULL) {
+		// the loop every all-sources run spends its time in, kept direct
+		for (int e = csr->outOffset[vertex]; e < csr->outOffset[vertex + 1]; e++) {
+			relax(ws, vertex, csr->outVertex[e], csr->outWeight[e]);
+		}
+		return vertex;
+	}
+	struct EdgeCursor edges;
+	Vertex w;
+	int weight;
+	edges_start(&edges, ws, vertex, false);
+	while (edges_next(&edges, ws, &w, &weight)) {
+		relax(ws, vertex, w, weight);
+	}
+	return vertex;
+}
+
+int dijkstraStepNextDist(DijkstraWorkspace ws) {
+	return IPQIsEmpty(ws->pq) ? INFINITY : IPQPeekKey(ws->pq);
+}
+
+void dijkstraStepStop(DijkstraWorkspace ws) {
+	IPQClear(ws->pq);
+}
+
+//******************************HELPER FUNCTIONS********************************
+
+// starts a run from src over a snapshot, or over g if csr is NULL
+static void start_run(DijkstraWorkspace ws, Vertex src, GraphCSR csr,
+                      Graph g) {
+	// without a snapshot the heaviest edge isn't known up front; room is
+	// reserved in the queue for each edge as it is met
+	begin_run(ws, src, csr != NULL ? csr->maxWeight : 0);
+	ws->csr = csr;
+	ws->graph = g;
+	set_dist(ws, src, 0);
+	IPQInsert(ws->pq, src, 0);
+}
+
+// forgets the last run and makes sure the queue can take the graph's edges
+static void begin_run(DijkstraWorkspace ws, Vertex src, int maxWeight) {
+	// only the vertices the last run touched have predecessor lists
+	for (int i = 0; i < ws->numTouched; i++) {
+		ws->pred[ws->touched[i]] = NULL;
+	}
+	predArrayReset(ws->pred);
+	ws->numTouched = 0;
+	ws->numSettled = 0;
+	ws->src = src;
+
+	ws->run++;
+	if (ws->run == 0) {
+		memset(ws->stamp, 0, ws->numNodes * sizeof(unsigned));
+		ws->run = 1;
+	}
+
+	if (ws->pq == NULL) {
+		ws->pq = IPQNew(ws->numNodes, ws->kind, maxWeight);
+		ws->pqMaxWeight = maxWeight;
+	}
+	else if (maxWeight > ws->pqMaxWeight) {
+		reserve_weight(ws, maxWeight);
+	}
+}
+
+// lets the queues take edges of up to maxWeight, keeping what they hold
+static void reserve_weight(DijkstraWorkspace ws, int maxWeight) {
+	IPQReserveWeight(ws->pq, maxWeight);
+	if (ws->backPq != NULL) {
+		IPQReserveWeight(ws->backPq, maxWeight);
+	}
+	ws->pqMaxWeight = maxWeight;
+}
+
+// points the cursor at the out edges of v, or its in edges if `in`
+static void edges_start(struct EdgeCursor *edges, DijkstraWorkspace ws,
+                        Vertex v, bool in) {
+	GraphCSR csr = ws->csr;
+	if (csr != NULL) {
+		edges->vertex = in ? csr->inVertex : csr->outVertex;
+		edges->weight = in ? csr->inWeight : csr->outWeight;
+		edges->e = in ? csr->inOffset[v] : csr->outOffset[v];
+		edges->end = in ? csr->inOffset[v + 1] : csr->outOffset[v + 1];
+		edges->curr = NULL;
+	}
+	else {
+		edges->vertex = NULL;
+		edges->curr = in ? GraphInIncident(ws->graph, v)
+		                 : GraphOutIncident(ws->graph, v);
+	}
+}
+
+// moves to the next edge, returning false once there are none left. Edges
+// read from the graph are checked against the queues' maximum weight.
+static bool edges_next(struct EdgeCursor *edges, DijkstraWorkspace ws,
+                       Vertex *w, int *weight) {
+	if (edges->vertex != NULL) {
+		if (edges->e == edges->end) {
+			return false;
+		}
+		*w = edges->vertex[edges->e];
+		*weight = edges->weight[edges->e];
+		edges->e++;
+		return true;
+	}
+	if (edges->curr == NULL) {
+		return false;
+	}
+	*w = edges->curr->v;
+	*weight = edges->curr->weight;
+	edges->curr = edges->curr->next;
+	if (*weight > ws->pqMaxWeight) {
+		reserve_weight(ws, *weight);
+	}
+	return true;
+}
+
+// relaxes the edge from the vertex just settled to w
+static void relax(DijkstraWorkspace ws, Vertex vertex, Vertex w, int weight) {
+	int new_dist = ws->dist[vertex] + weight;
+	int old_dist = dijkstraWorkspaceDist(ws, w);
+	// a shorter path replaces the predecessors found so far
+	if (new_dist < old_dist) {
+		set_dist(ws, w, new_dist);
+		predArraySet(ws->pred, w, vertex);
+		IPQInsert(ws->pq, w, new_dist);
+	}
+	// another path of the same length adds a predecessor
+	else if (new_dist == old_dist) {
+		predArrayPush(ws->pred, w, vertex);
+	}
+}
+
+// sets the distance to v in the current run, noting v as touched the first
+// time
+static void set_dist(DijkstraWorkspace ws, Vertex v, int dist) {
+	if (ws->stamp[v] != ws->run) {
+		ws->stamp[v] = ws->run;
+		ws->touched[ws->numTouched++] = v;
+	}
+	ws->dist[v] = dist;
+}
+
+// settles the vertices at most `radius` away and forgets the ones that
+// were reached but are further than that
+static void settle_within(DijkstraWorkspace ws, int radius) {
+	while (dijkstraStepNextDist(ws) <= radius) {
+		dijkstraStep(ws);
+	}
+	dijkstraStepStop(ws);
+	// every vertex still queued was further away than `radius`
+	for (int i = 0; i < ws->numTouched; i++) {
+		Vertex v = ws->touched[i];
+		if (ws->dist[v] > radius) {
+			forget(ws, v);
+		}
+	}
+}
+
+// makes a touched vertex read as unreached. Stamp 0 is never the current
+// run.
+static void forget(DijkstraWorkspace ws, Vertex v) {
+	ws->stamp[v] = 0;
+	ws->pred[v] = NULL;
+}
+
+// finds all shortest paths from src to dest (see dijkstraToInto)
+static void paths_to(DijkstraWorkspace ws, Vertex src, Vertex dest) {
+	int backward_top;
+	int mu = meeting_distance(ws, src, dest, &backward_top);
+	if (mu == INFINITY) {
+		// only the source is reached
+		begin_run(ws, src, 0);
+		set_dist(ws, src, 0);
+		ws->settled[ws->numSettled++] = src;
+		return;
+	}
+	paths_between(ws, src, mu, backward_top);
+	keep_paths_to(ws, dest);
+}
+
+// returns the length of the shortest path from src to dest (INFINITY if
+// there is none), searching forwards from src and backwards from dest at
+// the same time and always growing the side whose next vertex is closer.
+// Whenever an edge joins the two sides, the path through it is a
+// candidate. The search stops once the next vertices on the two sides are
+// further apart than the best candidate, as any other path would have to
+// be longer. Leaves the backward distances found in the workspace, and the
+// smallest backward distance still queued in `backward_top`: every vertex
+// not settled from dest is at least that far from it.
+static int meeting_distance(DijkstraWorkspace ws, Vertex src, Vertex dest,
+                            int *backward_top) {
+	start_run(ws, src, ws->csr, ws->graph);
+	begin_backward(ws);
+	set_backward_dist(ws, dest, 0);
+	IPQInsert(ws->backPq, dest, 0);
+	// best path length found so far
+	long long mu = src == dest ? 0 : INFINITY;
+
+	struct EdgeCursor edges;
+	Vertex w;
+	int weight;
+	while (!IPQIsEmpty(ws->pq) && !IPQIsEmpty(ws->backPq)) {
+		long long forward_key = IPQPeekKey(ws->pq);
+		long long backward_key = IPQPeekKey(ws->backPq);
+		if (forward_key + backward_key > mu) {
+			break;
+		}
+		if (forward_key <= backward_key) {
+			Vertex u = IPQDequeue(ws->pq);
+			edges_start(&edges, ws, u, false);
+			while (edges_next(&edges, ws, &w, &weight)) {
+				int new_dist = ws->dist[u] + weight;
+				if (new_dist < dijkstraWorkspaceDist(ws, w)) {
+					set_dist(ws, w, new_dist);
+					IPQInsert(ws->pq, w, new_dist);
+				}
+				// an edge joining the two sides
+				int other = backward_dist(ws, w);
+				long long through = (long long)new_dist + other;
+				if (other != INFINITY && through < mu) {
+					mu = through;
+				}
+			}
+		}
+		else {
+			Vertex u = IPQDequeue(ws->backPq);
+			edges_start(&edges, ws, u, true);
+			while (edges_next(&edges, ws, &w, &weight)) {
+				int new_dist = ws->backDist[u] + weight;
+				if (new_dist < backward_dist(ws, w)) {
+					set_backward_dist(ws, w, new_dist);
+					IPQInsert(ws->backPq, w, new_dist);
+				}
+				// an edge joining the two sides
+				int other = dijkstraWorkspaceDist(ws, w);
+				long long through = (long long)new_dist + other;
+				if (other != INFINITY && through < mu) {
+					mu = through;
+				}
+			}
+		}
+	}
+	// if the backward search ran out, every vertex that can reach dest was
+	// settled from it
+	*backward_top = IPQIsEmpty(ws->backPq) ? INFINITY
+	                                        : IPQPeekKey(ws->backPq);
+	IPQClear(ws->pq);
+	IPQClear(ws->backPq);
+	return (int)mu;
+}
+
+// runs dijkstra from src, only following edges into vertices that could
+// still lie on a path of length mu to dest. A vertex's distance to dest is
+// bounded below by its backward distance if the backward search settled
+// it, and by backward_top if not, so the smaller of the two is used. Every
+// vertex on a shortest path to dest passes the test, so their distances
+// and predecessor lists come out the same as from a full run.
+static void paths_between(DijkstraWorkspace ws, Vertex src, int mu,
+                          int backward_top) {
+	start_run(ws, src, ws->csr, ws->graph);
+	struct EdgeCursor edges;
+	Vertex w;
+	int weight;
+	while (!IPQIsEmpty(ws->pq)) {
+		Vertex vertex = IPQDequeue(ws->pq);
+		ws->settled[ws->numSettled++] = vertex;
+		edges_start(&edges, ws, vertex, false);
+		while (edges_next(&edges, ws, &w, &weight)) {
+			int backward = backward_dist(ws, w);
+			int remaining = backward < backward_top ? backward : backward_top;
+			if ((long long)ws->dist[vertex] + weight + remaining > mu) {
+				continue;
+			}
+			relax(ws, vertex, w, weight);
+		}
+	}
+}
+
+// keeps only the vertices that dest can be reached from by following
+// predecessor lists backwards (the ones on shortest paths from the source
+// to dest), forgetting every other vertex but the source. Edge weights are
+// positive, so a vertex's predecessors were settled before it and one pass
+// back over the settle order finds them all.
+static void keep_paths_to(DijkstraWorkspace ws, Vertex dest) {
+	// the backward distances aren't needed any more, so a new backward run
+	// marks the vertices on the paths
+	begin_backward(ws);
+	ws->backStamp[dest] = ws->backRun;
+	for (int i = ws->numSettled - 1; i >= 0; i--) {
+		Vertex v = ws->settled[i];
+		if (ws->backStamp[v] != ws->backRun) continue;
+		for (PredNode *curr = ws->pred[v]; curr != NULL; curr = curr->next) {
+			ws->backStamp[curr->v] = ws->backRun;
+		}
+	}
+
+	int kept = 0;
+	for (int i = 0; i < ws->numSettled; i++) {
+		Vertex v = ws->settled[i];
+		if (ws->backStamp[v] == ws->backRun || v == ws->src) {
+			ws->settled[kept++] = v;
+		}
+	}
+	ws->numSettled = kept;
+	for (int i = 0; i < ws->numTouched; i++) {
+		Vertex v = ws->touched[i];
+		if (ws->backStamp[v] != ws->backRun && v != ws->src) {
+			forget(ws, v);
+		}
+	}
+}
+
+// starts a new backward run, allocating the backward search the first time
+static void begin_backward(DijkstraWorkspace ws) {
+	if (ws->backStamp == NULL) {
+		int size = ws->numNodes > 0 ? ws->numNodes : 1;
+		ws->backStamp = calloc(size, sizeof(unsigned));
+		ws->backDist = malloc(size * sizeof(int));
+		assert(ws->backStamp != NULL && ws->backDist != NULL);
+		ws->backPq = IPQNew(ws->numNodes, ws->kind, ws->pqMaxWeight);
+	}
+	ws->backRun++;
+	if (ws->backRun == 0) {
+		memset(ws->backStamp, 0, ws->numNodes * sizeof(unsigned));
+		ws->backRun = 1;
+	}
+}
+
+// returns the distance from v to the target of the backward run, or
+// INFINITY if the backward search has not reached v
+static int backward_dist(DijkstraWorkspace ws, Vertex v) {
+	return ws->backStamp[v] == ws->backRun ? ws->backDist[v] : INFINITY;
+}
+
+static void set_backward_dist(DijkstraWorkspace ws, Vertex v, int dist) {
+	ws->backStamp[v] = ws->backRun;
+	ws->backDist[v] = dist;
+}
@@ -0,0 +1,165 @@
+// Reusable Dijkstra workspace interface
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Buffers for running dijkstra from many sources over graphs of the same
+// size without allocating anything per source. Each run overwrites the
+// results of the previous one. Distances are stamped with the run they were
+// set in, so a stale entry reads as INFINITY and starting a run costs
+// nothing; the predecessor lists of the vertices the last run touched are
+// the only thing cleared. A run therefore takes time proportional to the
+// vertices and edges it reaches, not to the size of the graph.
+
+#ifndef DIJKSTRA_WORKSPACE_H
+#define DIJKSTRA_WORKSPACE_H
+
+#include "Dijkstra.h"
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "IndexedPQ.h"
+
+// returned by dijkstraStep when the run is over
+#define NO_VERTEX -1
+
+typedef struct DijkstraWorkspaceRep {
+	int numNodes;
+	Vertex src;        // source of the last run
+	int numSettled;
+	Vertex *settled;   // vertices settled by the last run, in the order
+	                   // they were settled (non-decreasing distance; equal
+	                   // distances in increasing vertex order with the
+	                   // binary heap)
+	PredNode **pred;   // predecessor lists, as in ShortestPaths; NULL for
+	                   // vertices the last run did not reach
+
+	// the rest is internal to DijkstraWorkspace.c
+	GraphCSR csr;      // graph of the current run, if it is a snapshot
+	Graph graph;       // graph of the current run otherwise
+	int *dist;
+	unsigned *stamp;   // run in which dist[v] was last set
+	unsigned run;
+	int numTouched;
+	Vertex *touched;   // vertices whose dist was set in this run
+	IPQKind kind;
+	IPQ pq;
+	int pqMaxWeight;   // largest edge weight the queues can handle
+	// backward search of point-to-point queries, allocated by the first one
+	int *backDist;
+	unsigned *backStamp;
+	unsigned backRun;
+	IPQ backPq;
+} *DijkstraWorkspace;
+
+/**
+ * Creates a workspace for graphs with numNodes vertices, using the queue
+ * kind given by IPQDefaultKind().
+ */
+DijkstraWorkspace dijkstraWorkspaceNew(int numNodes);
+
+/**
+ * Same as dijkstraWorkspaceNew(), using the given kind of priority queue.
+ */
+DijkstraWorkspace dijkstraWorkspaceNewWithQueue(int numNodes, IPQKind kind);
+
+/**
+ * Frees all memory associated with the given workspace.
+ */
+void dijkstraWorkspaceFree(DijkstraWorkspace ws);
+
+/**
+ * Finds the shortest paths from src, leaving them in the workspace. The
+ * graph must have the workspace's number of vertices. The edges are read
+ * straight from the graph's adjacency lists, so a run only costs as much
+ * as the part of the graph it reaches; dijkstraCSRInto() is still faster
+ * per edge when running many sources over a graph that doesn't change.
+ */
+void dijkstraInto(Graph g, Vertex src, DijkstraWorkspace ws);
+
+/**
+ * Same as dijkstraInto(), reading the edges from a graph snapshot.
+ */
+void dijkstraCSRInto(GraphCSR csr, Vertex src, DijkstraWorkspace ws);
+
+/**
+ * Same as dijkstraCSRInto(), but stops as soon as dest is settled. All
+ * shortest paths to dest are then complete: `settled` holds the vertices
+ * settled so far, ending with dest (or every reachable vertex if dest
+ * can't be reached), and the predecessors of every settled vertex are
+ * settled. Vertices that were reached but not settled have tentative
+ * distances and predecessors.
+ */
+void dijkstraCSRIntoTarget(GraphCSR csr, Vertex src, Vertex dest,
+                           DijkstraWorkspace ws);
+
+/**
+ * Finds  all  shortest paths from src to dest only, as dijkstraTo() does,
+ * leaving them in the workspace: `settled` holds src and the vertices on
+ * those paths, in the order they were settled, and every other vertex
+ * reads as unreached. Both searches only cost as much as the part of the
+ * graph they reach, so this is the form to use for repeated queries;
+ * dijkstraTo() sets up a whole workspace each time.
+ */
+void dijkstraToInto(Graph g, Vertex src, Vertex dest, DijkstraWorkspace ws);
+
+/**
+ * Same as dijkstraToInto(), reading the edges from a graph snapshot. The
+ * snapshot must hold the in edges too (GraphCSRNew(), not GraphCSRNewOut()).
+ */
+void dijkstraCSRToInto(GraphCSR csr, Vertex src, Vertex dest,
+                       DijkstraWorkspace ws);
+
+/**
+ * Finds the shortest paths from src to the vertices at most `radius` (>= 0)
+ * away, as dijkstraWithin() does, leaving them in the workspace. Vertices
+ * further away read as unreached.
+ */
+void dijkstraWithinInto(Graph g, Vertex src, int radius,
+                        DijkstraWorkspace ws);
+
+/**
+ * Same as dijkstraWithinInto(), reading the edges from a graph snapshot.
+ */
+void dijkstraCSRWithinInto(GraphCSR csr, Vertex src, int radius,
+                           DijkstraWorkspace ws);
+
+/**
+ * Copies the results of the last run into a new ShortestPaths structure,
+ * to be released with freeShortestPaths(). The predecessor lists keep
+ * their order.
+ */
+ShortestPaths dijkstraWorkspacePaths(DijkstraWorkspace ws);
+
+/**
+ * Starts a run from src that is carried out one vertex at a time with
+ * dijkstraStep(), so the caller can look at the partial results (the
+ * settled vertices, their distances and predecessors) and stop early.
+ * The snapshot must stay alive until the run is over.
+ */
+void dijkstraStepStart(GraphCSR csr, Vertex src, DijkstraWorkspace ws);
+
+/**
+ * Settles the closest vertex not yet settled, relaxes its out edges and
+ * returns it, or returns NO_VERTEX if every reachable vertex is settled.
+ */
+Vertex dijkstraStep(DijkstraWorkspace ws);
+
+/**
+ * Returns the distance of the vertex the next dijkstraStep() will settle,
+ * or INFINITY if there is none. No vertex settled later is any closer.
+ */
+int dijkstraStepNextDist(DijkstraWorkspace ws);
+
+/**
+ * Ends a run early. The results so far stay readable, as after
+ * dijkstraCSRIntoTarget().
+ */
+void dijkstraStepStop(DijkstraWorkspace ws);
+
+/**
+ * Returns the distance from the last run's source to v, or INFINITY if v
+ * was not reached.
+ */
+static inline int dijkstraWorkspaceDist(DijkstraWorkspace ws, Vertex v) {
+	return ws->stamp[v] == ws->run ? ws->dist[v] : INFINITY;
+}
+
+#endif
@@ -0,0 +1,98 @@
+// Compressed sparse row graph snapshot implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Graph.h"
+#include "GraphCSR.h"
+
+//***********************FUNCTION DECLARATIONS**********************************
+static GraphCSR csr_new(Graph g, bool withIn);
+static int fill_direction(Graph g, AdjList (*incident)(Graph, Vertex),
+                          int *offset, Vertex **vertex, int **weight);
+//******************************************************************************
+
+GraphCSR GraphCSRNew(Graph g) {
+	return csr_new(g, true);
+}
+
+GraphCSR GraphCSRNewOut(Graph g) {
+	return csr_new(g, false);
+}
+
+void GraphCSRFree(GraphCSR csr) {
+	free(csr->outOffset);
+	free(csr->outVertex);
+	free(csr->outWeight);
+	free(csr->inOffset);
+	free(csr->inVertex);
+	free(csr->inWeight);
+	free(csr);
+}
+
+//******************************HELPER FUNCTIONS********************************
+
+// builds a snapshot of the out edges, and of the in edges if withIn is set
+static GraphCSR csr_new(Graph g, bool withIn) {
+	GraphCSR csr = malloc(sizeof(*csr));
+	assert(csr != NULL);
+	csr->numNodes = GraphNumVertices(g);
+	csr->outOffset = malloc((csr->numNodes + 1) * sizeof(int));
+	assert(csr->outOffset != NULL);
+	csr->numEdges = fill_direction(g, GraphOutIncident, csr->outOffset,
+	                               &csr->outVertex, &csr->outWeight);
+
+	csr->inOffset = NULL;
+	csr->inVertex = NULL;
+	csr->inWeight = NULL;
+	if (withIn) {
+		csr->inOffset = malloc((csr->numNodes + 1) * sizeof(int));
+		assert(csr->inOffset != NULL);
+		fill_direction(g, GraphInIncident, csr->inOffset,
+		               &csr->inVertex, &csr->inWeight);
+	}
+
+	csr->maxWeight = 0;
+	for (int e = 0; e < csr->numEdges; e++) {
+		if (csr->outWeight[e] > csr->maxWeight) {
+			csr->maxWeight = csr->outWeight[e];
+		}
+	}
+	return csr;
+}
+
+// copies one direction of the adjacency lists into flat arrays and returns
+// the number of edges copied
+static int fill_direction(Graph g, AdjList (*incident)(Graph, Vertex),
+                          int *offset, Vertex **vertex, int **weight) {
+	int num_nodes = GraphNumVertices(g);
+	// first pass counts the edges of each vertex
+	offset[0] = 0;
+	for (int v = 0; v < num_nodes; v++) {
+		int degree = 0;
+		for (AdjList curr = incident(g, v); curr != NULL; curr = curr->next) {
+			degree++;
+		}
+		offset[v + 1] = offset[v] + degree;
+	}
+
+	int num_edges = offset[num_nodes];
+	*vertex = malloc((num_edges > 0 ? num_edges : 1) * sizeof(Vertex));
+	*weight = malloc((num_edges > 0 ? num_edges : 1) * sizeof(int));
+	assert(*vertex != NULL && *weight != NULL);
+
+	// second pass copies them, keeping the adjacency list order
+	for (int v = 0; v < num_nodes; v++) {
+		int e = offset[v];
+		for (AdjList curr = incident(g, v); curr != NULL; curr = curr->next) {
+			(*vertex)[e] = curr->v;
+			(*weight)[e] = curr->weight;
+			e++;
+		}
+	}
+	return num_edges;
+}
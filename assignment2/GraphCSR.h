@@ -0,0 +1,46 @@
+// Compressed sparse row graph snapshot interface
+// COMP2521 Assignment 2
+// James Teng z5361442
+// A frozen copy of a Graph with the out and in edges of every vertex laid
+// out contiguously. The edges of vertex v are at indices
+// outOffset[v]..outOffset[v + 1] - 1 of outVertex/outWeight (likewise for
+// the in direction), in the same order as GraphOutIncident/GraphInIncident
+// return them. The snapshot does not see later changes to the Graph.
+
+#ifndef GRAPH_CSR_H
+#define GRAPH_CSR_H
+
+#include "Graph.h"
+
+typedef struct GraphCSRRep {
+	int numNodes;
+	int numEdges;
+	int maxWeight;     // largest edge weight (0 if there are no edges)
+
+	int *outOffset;    // numNodes + 1 offsets into outVertex/outWeight
+	Vertex *outVertex; // destination of each out edge
+	int *outWeight;
+
+	int *inOffset;     // numNodes + 1 offsets into inVertex/inWeight
+	Vertex *inVertex;  // source of each in edge
+	int *inWeight;
+} *GraphCSR;
+
+/**
+ * Builds a snapshot of the given graph.
+ */
+GraphCSR GraphCSRNew(Graph g);
+
+/**
+ * Builds a snapshot of the out edges only, for algorithms that never look
+ * at in edges (such as a single dijkstra). The in direction fields are
+ * NULL.
+ */
+GraphCSR GraphCSRNewOut(Graph g);
+
+/**
+ * Frees all memory associated with the given snapshot.
+ */
+void GraphCSRFree(GraphCSR csr);
+
+#endif
@@ -0,0 +1,276 @@
+// Indexed Priority Queue ADT implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+// The binary heap keeps pos[item] (its index in the heap array) so that
+// decrease-key is a sift-up from the item's current slot. The bucket queue
+// keeps maxWeight + 1 circular buckets of doubly linked items; lowering a
+// key unlinks the item and relinks it into its new bucket. Reserving a
+// larger weight relinks every queued item into a bigger ring.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "IndexedPQ.h"
+
+#define ABSENT -1
+
+struct IPQRep {
+	IPQKind kind;
+	int capacity;
+	int size;
+	int *key;      // current key of each queued item
+	int *pos;      // heap slot of each item, or ABSENT
+
+	// binary heap
+	int *heap;
+
+	// bucket queue
+	int numBuckets;
+	int current;   // smallest key that may still be in the queue
+	int *bucket;   // head item of each bucket, or ABSENT
+	int *next;     // neighbouring items in the same bucket
+	int *prev;
+};
+
+//***********************FUNCTION DECLARATIONS**********************************
+static bool heap_less(IPQ pq, int a, int b);
+static void heap_swap(IPQ pq, int i, int j);
+static void sift_up(IPQ pq, int i);
+static void sift_down(IPQ pq, int i);
+static void bucket_link(IPQ pq, int item);
+static void bucket_unlink(IPQ pq, int item);
+static void bucket_advance(IPQ pq);
+//******************************************************************************
+
+IPQ IPQNew(int capacity, IPQKind kind, int maxWeight) {
+	IPQ pq = malloc(sizeof(*pq));
+	assert(pq != NULL);
+	pq->kind = kind;
+	pq->capacity = capacity;
+	pq->size = 0;
+	pq->key = malloc(capacity * sizeof(int));
+	pq->pos = malloc(capacity * sizeof(int));
+	assert(pq->key != NULL && pq->pos != NULL);
+	for (int i = 0; i < capacity; i++) {
+		pq->pos[i] = ABSENT;
+	}
+	pq->heap = NULL;
+	pq->bucket = pq->next = pq->prev = NULL;
+	pq->numBuckets = 0;
+	pq->current = 0;
+
+	if (kind == IPQ_BINARY_HEAP) {
+		pq->heap = malloc(capacity * sizeof(int));
+		assert(pq->heap != NULL);
+	}
+	else {
+		assert(maxWeight >= 0);
+		pq->numBuckets = maxWeight + 1;
+		pq->bucket = malloc(pq->numBuckets * sizeof(int));
+		pq->next = malloc(capacity * sizeof(int));
+		pq->prev = malloc(capacity * sizeof(int));
+		assert(pq->bucket != NULL && pq->next != NULL && pq->prev != NULL);
+		for (int b = 0; b < pq->numBuckets; b++) {
+			pq->bucket[b] = ABSENT;
+		}
+	}
+	return pq;
+}
+
+void IPQReserveWeight(IPQ pq, int maxWeight) {
+	if (pq->kind != IPQ_BUCKET || maxWeight < pq->numBuckets) {
+		return;
+	}
+	// at least double the buckets, so a run that keeps meeting heavier
+	// edges only moves its items a few times
+	int *old_bucket = pq->bucket;
+	int old_num_buckets = pq->numBuckets;
+	pq->numBuckets = 2 * old_num_buckets > maxWeight + 1 ? 2 * old_num_buckets
+	                                                      : maxWeight + 1;
+	pq->bucket = malloc(pq->numBuckets * sizeof(int));
+	assert(pq->bucket != NULL);
+	for (int b = 0; b < pq->numBuckets; b++) {
+		pq->bucket[b] = ABSENT;
+	}
+	// every queued key is within old_num_buckets of `current`, so each
+	// item goes into its own bucket of the bigger ring
+	for (int b = 0; b < old_num_buckets; b++) {
+		int item = old_bucket[b];
+		while (item != ABSENT) {
+			int next = pq->next[item];
+			bucket_link(pq, item);
+			item = next;
+		}
+	}
+	free(old_bucket);
+}
+
+void IPQFree(IPQ pq) {
+	free(pq->key);
+	free(pq->pos);
+	free(pq->heap);
+	free(pq->bucket);
+	free(pq->next);
+	free(pq->prev);
+	free(pq);
+}
+
+void IPQClear(IPQ pq) {
+	// only the queued items need their positions reset
+	while (!IPQIsEmpty(pq)) {
+		IPQDequeue(pq);
+	}
+	pq->current = 0;
+}
+
+void IPQInsert(IPQ pq, int item, int key) {
+	assert(item >= 0 && item < pq->capacity);
+	if (pq->pos[item] != ABSENT) {
+		// already queued - only ever lower the key
+		if (key >= pq->key[item]) return;
+		if (pq->kind == IPQ_BINARY_HEAP) {
+			pq->key[item] = key;
+			sift_up(pq, pq->pos[item]);
+		}
+		else {
+			bucket_unlink(pq, item);
+			pq->key[item] = key;
+			bucket_link(pq, item);
+		}
+		return;
+	}
+
+	pq->key[item] = key;
+	if (pq->kind == IPQ_BINARY_HEAP) {
+		pq->heap[pq->size] = item;
+		pq->pos[item] = pq->size;
+		pq->size++;
+		sift_up(pq, pq->size - 1);
+	}
+	else {
+		if (pq->size == 0 || key < pq->current) {
+			pq->current = key;
+		}
+		assert(key - pq->current < pq->numBuckets);
+		bucket_link(pq, item);
+		pq->size++;
+	}
+}
+
+int IPQDequeue(IPQ pq) {
+	assert(pq->size > 0);
+	int item;
+	if (pq->kind == IPQ_BINARY_HEAP) {
+		item = pq->heap[0];
+		pq->size--;
+		if (pq->size > 0) {
+			heap_swap(pq, 0, pq->size);
+			sift_down(pq, 0);
+		}
+	}
+	else {
+		bucket_advance(pq);
+		item = pq->bucket[pq->current % pq->numBuckets];
+		bucket_unlink(pq, item);
+		pq->size--;
+	}
+	pq->pos[item] = ABSENT;
+	return item;
+}
+
+int IPQPeekKey(IPQ pq) {
+	assert(pq->size > 0);
+	if (pq->kind == IPQ_BINARY_HEAP) {
+		return pq->key[pq->heap[0]];
+	}
+	bucket_advance(pq);
+	return pq->current;
+}
+
+bool IPQIsEmpty(IPQ pq) {
+	return pq->size == 0;
+}
+
+IPQKind IPQDefaultKind(void) {
+	char *env = getenv(IPQ_KIND_ENV);
+	if (env != NULL && strcmp(env, "bucket") == 0) {
+		return IPQ_BUCKET;
+	}
+	return IPQ_BINARY_HEAP;
+}
+
+//***************************BINARY HEAP HELPERS********************************
+
+// orders heap slots by key, then by item so ties are reproducible
+static bool heap_less(IPQ pq, int a, int b) {
+	int item_a = pq->heap[a];
+	int item_b = pq->heap[b];
+	if (pq->key[item_a] != pq->key[item_b]) {
+		return pq->key[item_a] < pq->key[item_b];
+	}
+	return item_a < item_b;
+}
+
+static void heap_swap(IPQ pq, int i, int j) {
+	int temp = pq->heap[i];
+	pq->heap[i] = pq->heap[j];
+	pq->heap[j] = temp;
+	pq->pos[pq->heap[i]] = i;
+	pq->pos[pq->heap[j]] = j;
+}
+
+static void sift_up(IPQ pq, int i) {
+	while (i > 0 && heap_less(pq, i, (i - 1) / 2)) {
+		heap_swap(pq, i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+}
+
+static void sift_down(IPQ pq, int i) {
+	while (2 * i + 1 < pq->size) {
+		int child = 2 * i + 1;
+		if (child + 1 < pq->size && heap_less(pq, child + 1, child)) {
+			child++;
+		}
+		if (!heap_less(pq, child, i)) break;
+		heap_swap(pq, i, child);
+		i = child;
+	}
+}
+
+//***************************BUCKET QUEUE HELPERS*******************************
+
+// pushes item onto the front of the bucket for its key
+static void bucket_link(IPQ pq, int item) {
+	int b = pq->key[item] % pq->numBuckets;
+	pq->prev[item] = ABSENT;
+	pq->next[item] = pq->bucket[b];
+	if (pq->bucket[b] != ABSENT) {
+		pq->prev[pq->bucket[b]] = item;
+	}
+	pq->bucket[b] = item;
+	// pos only marks membership for the bucket queue
+	pq->pos[item] = b;
+}
+
+static void bucket_unlink(IPQ pq, int item) {
+	int b = pq->key[item] % pq->numBuckets;
+	if (pq->prev[item] != ABSENT) {
+		pq->next[pq->prev[item]] = pq->next[item];
+	}
+	else {
+		pq->bucket[b] = pq->next[item];
+	}
+	if (pq->next[item] != ABSENT) {
+		pq->prev[pq->next[item]] = pq->prev[item];
+	}
+}
+
+// moves `current` forward to the first non-empty bucket
+static void bucket_advance(IPQ pq) {
+	while (pq->bucket[pq->current % pq->numBuckets] == ABSENT) {
+		pq->current++;
+	}
+}
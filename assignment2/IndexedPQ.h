@@ -0,0 +1,80 @@
+// Indexed Priority Queue ADT interface
+// COMP2521 Assignment 2
+// James Teng z5361442
+// A min priority queue over the items 0..capacity-1 that tracks where each
+// item lives, so an item's key can be lowered in place instead of being
+// inserted a second time. Two implementations can be picked at runtime:
+//   * IPQ_BINARY_HEAP - binary heap, any non-negative integer keys
+//   * IPQ_BUCKET      - Dial's bucket queue for integer edge weights no
+//                       larger than a known maximum. Keys must be
+//                       dequeued in non-decreasing order (as in Dijkstra)
+
+#ifndef INDEXED_PQ_H
+#define INDEXED_PQ_H
+
+#include <stdbool.h>
+
+// environment variable consulted by IPQDefaultKind ("heap" or "bucket")
+#define IPQ_KIND_ENV "DIJKSTRA_QUEUE"
+
+typedef enum {
+	IPQ_BINARY_HEAP,
+	IPQ_BUCKET,
+} IPQKind;
+
+typedef struct IPQRep *IPQ;
+
+/**
+ * Creates  a  new  empty  queue for the items 0..capacity-1. `maxWeight`
+ * is the largest amount a key can exceed the most recently dequeued key
+ * by; it is only used by IPQ_BUCKET.
+ */
+IPQ IPQNew(int capacity, IPQKind kind, int maxWeight);
+
+/**
+ * Makes  sure  the  queue  can take keys up to `maxWeight` past the most
+ * recently dequeued key, as if it had been created with that maxWeight.
+ * Queued items stay queued. Does nothing for IPQ_BINARY_HEAP.
+ */
+void IPQReserveWeight(IPQ pq, int maxWeight);
+
+/**
+ * Frees all memory associated with the given queue.
+ */
+void IPQFree(IPQ pq);
+
+/**
+ * Removes every item from the queue, keeping its storage for reuse.
+ */
+void IPQClear(IPQ pq);
+
+/**
+ * Adds  `item`  with the given key, or lowers its key if it is already in
+ * the queue. Does nothing if the item is queued with a smaller key.
+ */
+void IPQInsert(IPQ pq, int item, int key);
+
+/**
+ * Removes  and returns the item with the smallest key. Ties are broken
+ * in favour of the smaller item in IPQ_BINARY_HEAP.
+ */
+int IPQDequeue(IPQ pq);
+
+/**
+ * Returns  the  smallest  key in the queue without removing it. Assumes
+ * the queue is not empty.
+ */
+int IPQPeekKey(IPQ pq);
+
+/**
+ * Returns true if the queue is empty.
+ */
+bool IPQIsEmpty(IPQ pq);
+
+/**
+ * Returns the queue kind named by the DIJKSTRA_QUEUE environment
+ * variable, defaulting to IPQ_BINARY_HEAP.
+ */
+IPQKind IPQDefaultKind(void);
+
+#endif
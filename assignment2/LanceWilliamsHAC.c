@@ -12,15 +12,40 @@
 #include <stdlib.h>
 
 #include "Graph.h"
+#include "GraphCSR.h"
 #include "LanceWilliamsHAC.h"
+#include "LanceWilliamsHACVariants.h"
 
-#define INFINITY DBL_MAX
 #define PAIR 2
 
-static int *smallest_dist(int vertices_num, Dendrogram *cluster, double **dist);
+// distances are doubles unless built with -DHAC_FLOAT_DIST, which halves the
+// memory used by the distance matrix again
+#ifdef HAC_FLOAT_DIST
+typedef float Distance;
+#define INFINITY FLT_MAX
+#else
+typedef double Distance;
+#define INFINITY DBL_MAX
+#endif
+
+// the distance matrix is symmetric, so only the upper triangle (i < j) is
+// kept, row after row in one contiguous buffer
+typedef struct DistMatrix {
+	int n;
+	Distance *cells;
+} DistMatrix;
+
+static void closest_pair(int vertices_num, Dendrogram *cluster, int *nn,
+                         Distance *nn_dist, int *vertex_index);
+static void nearest_neighbour(DistMatrix *dist, Dendrogram *cluster,
+                              int i, int *nn, Distance *nn_dist);
+static void update_neighbours(DistMatrix *dist, Dendrogram *cluster,
+                              int *vertex_index, int *nn, Distance *nn_dist);
 static void combine_clusters(Dendrogram *cluster, int *vertex_index);
-static void lance_williams(double **dist, int vertices_num, int *vertex_index, int method);
-static double find_max_weight(Graph g, Vertex i, Vertex j);
+static void lance_williams(DistMatrix *dist, int *vertex_index, int method);
+static void distance_matrix(GraphCSR csr, DistMatrix *dist);
+static size_t row_offset(int n, int i);
+static Distance *dist_cell(DistMatrix *dist, int i, int j);
 
 /**
  * Generates  a Dendrogram using the Lance-Williams algorithm (discussed
@@ -31,27 +56,17 @@ static double find_max_weight(Graph g, Vertex i, Vertex j);
  * The function returns a 'Dendrogram' structure.
  */
 Dendrogram LanceWilliamsHAC(Graph g, int method) {
-	int vertices_num = GraphNumVertices(g);
-	// create a 2D visited array
-	double **dist = malloc(vertices_num * sizeof(*dist));
-	for (int i = 0; i < vertices_num; i++) {
-		dist[i] = malloc(vertices_num * sizeof(double));
-		for (int j = 0; j < vertices_num; j++) {
-			if (i == j) {
-				dist[i][j] = -1;
-			}
-			// runs if a direct edge exists between vertices i and j
-			else if (GraphIsAdjacent(g, i, j) || GraphIsAdjacent(g, j, i)) {
-				// find max weight of edges between vertex i and j
-				double max_weight = find_max_weight(g, i, j);
-				dist[i][j] = 1.0/max_weight;
-			}
-			// if there is no edge between vertices i and j
-			else {
-				dist[i][j] = INFINITY;
-			}
-		}
-	}
+	GraphCSR csr = GraphCSRNewOut(g);
+	Dendrogram d = LanceWilliamsHACCSR(csr, method);
+	GraphCSRFree(csr);
+	return d;
+}
+
+Dendrogram LanceWilliamsHACCSR(GraphCSR csr, int method) {
+	int vertices_num = csr->numNodes;
+	// create the condensed distance matrix
+	DistMatrix dist;
+	distance_matrix(csr, &dist);
 	// create array of dendrograms with a dendrogram "cluster" for each vertex
 	Dendrogram *cluster = malloc(vertices_num * sizeof(Dendrogram));
 	for (int i = 0; i < vertices_num; i++) {
@@ -61,49 +76,106 @@ Dendrogram LanceWilliamsHAC(Graph g, int method) {
 		cluster[i]->right = NULL;
 		cluster[i]->left = NULL;
 	}
+	// nearest neighbour of each cluster among the higher indexed clusters
+	int *nn = malloc(vertices_num * sizeof(int));
+	Distance *nn_dist = malloc(vertices_num * sizeof(Distance));
+	for (int i = 0; i < vertices_num; i++) {
+		nearest_neighbour(&dist, cluster, i, nn, nn_dist);
+	}
 	// loop to keep merging clusters until there is one cluster left
 	for (int i = 0; i < vertices_num - 1; i++) {
 		// store index of pair of clusters with the smallest distance
-		int *vertex_index = smallest_dist(vertices_num, cluster, dist);
+		int vertex_index[PAIR];
+		closest_pair(vertices_num, cluster, nn, nn_dist, vertex_index);
 		combine_clusters(cluster, vertex_index);
 		// recalculate distances between new cluster and the other clusters
-		lance_williams(dist, vertices_num, vertex_index, method);
-		free(vertex_index);
+		lance_williams(&dist, vertex_index, method);
+		update_neighbours(&dist, cluster, vertex_index, nn, nn_dist);
 	}
+	free(nn);
+	free(nn_dist);
 	// after merging all clusters, the final dendrogram will be in index 0 
 	Dendrogram final_cluster = cluster[0];
 
-	// free individual dist matrix cells and clusters
-	for (int i = 0; i < vertices_num; i++) {
-		free(dist[i]);
-	}
-	free(dist);
+	// free the dist matrix and clusters
+	free(dist.cells);
 	free(cluster);
 
 	return final_cluster;
 }
 
-//find pair of cluster with smallest distance between them
-// returns index of the pair of cluster in the malloc'd vertex_index array
-static int *smallest_dist(int vertices_num, Dendrogram *cluster, double **dist) {
-	int *vertex_index = malloc(PAIR * sizeof(int)); 
+// finds the pair of clusters with the smallest distance between them, using
+// the cached nearest neighbours. Picks the same pair a row-major scan of the
+// whole matrix would: the smallest row, then the smallest column in it.
+// If no two clusters are connected, the two lowest indexed clusters are
+// merged.
+static void closest_pair(int vertices_num, Dendrogram *cluster, int *nn,
+                         Distance *nn_dist, int *vertex_index) {
+	Distance min_dist = INFINITY;
+	vertex_index[0] = vertex_index[1] = -1;
+	for (int i = 0; i < vertices_num; i++) {
+		if (cluster[i] != NULL && nn[i] != -1 && nn_dist[i] < min_dist) {
+			min_dist = nn_dist[i];
+			vertex_index[0] = i;
+			vertex_index[1] = nn[i];
+		}
+	}
+	if (vertex_index[0] != -1) return;
 
-	double min_dist = INFINITY;
-	// loop through all possible combinations of vertices
+	// no finite distances left - fall back to the first two clusters
 	for (int i = 0; i < vertices_num; i++) {
-		for (int j = 0; j < vertices_num; j++) {
-			
-			// update dist array if distance between i and j is less than the 
-			// minimum distance
-			if (dist[i][j] > 0 && dist[i][j] < min_dist) {
-				min_dist = dist[i][j];
-				// update array with the index of the vertices
-				vertex_index[0] = i;
-				vertex_index[1] = j;
-			}
+		if (cluster[i] == NULL) continue;
+		if (vertex_index[0] == -1) {
+			vertex_index[0] = i;
+		}
+		else {
+			vertex_index[1] = i;
+			return;
+		}
+	}
+}
+
+// finds the closest cluster j > i to cluster i (the lowest j on ties), or
+// -1 if cluster i is not connected to any of them
+static void nearest_neighbour(DistMatrix *dist, Dendrogram *cluster,
+                              int i, int *nn, Distance *nn_dist) {
+	nn[i] = -1;
+	nn_dist[i] = INFINITY;
+	// the j > i half of row i is contiguous in the condensed matrix
+	Distance *row = &dist->cells[row_offset(dist->n, i)];
+	for (int j = i + 1; j < dist->n; j++) {
+		Distance d = row[j - i - 1];
+		if (cluster[j] != NULL && d > 0 && d < nn_dist[i]) {
+			nn[i] = j;
+			nn_dist[i] = d;
+		}
+	}
+}
+
+// brings the cached nearest neighbours up to date after clusters v1 < v2
+// have been merged into v1. Only rows that pointed at v1 or v2, or that
+// are now closer to v1, can change; rows after v2 never look at either.
+static void update_neighbours(DistMatrix *dist, Dendrogram *cluster,
+                              int *vertex_index, int *nn, Distance *nn_dist) {
+	int v1 = vertex_index[0];
+	int v2 = vertex_index[1];
+	nearest_neighbour(dist, cluster, v1, nn, nn_dist);
+	for (int k = 0; k < v2; k++) {
+		if (k == v1 || cluster[k] == NULL) continue;
+		Distance d = *dist_cell(dist, k, v1);
+		if (nn[k] == v1 && d > 0 && d <= nn_dist[k]) {
+			// still the nearest, possibly closer than before
+			nn_dist[k] = d;
+		}
+		else if (nn[k] == v1 || nn[k] == v2) {
+			nearest_neighbour(dist, cluster, k, nn, nn_dist);
+		}
+		else if (k < v1 && d > 0 && (d < nn_dist[k] ||
+		         (d == nn_dist[k] && v1 < nn[k]))) {
+			nn[k] = v1;
+			nn_dist[k] = d;
 		}
 	}
-	return vertex_index;
 }
 
 // create a malloc'd cluster which merges a pair of clusters
@@ -129,98 +201,83 @@ static void combine_clusters(Dendrogram *cluster, int *vertex_index) {
 }
 
 // implement the lance williams algorithm to readjust values of the dist array
-static void lance_williams(double **dist, int vertices_num, int *vertex_index, int method) {
+static void lance_williams(DistMatrix *dist, int *vertex_index, int method) {
 	int v1 = vertex_index[0];
 	int v2 = vertex_index[1];
 	// index of the newly merged cluster
 	int new_cluster = v1;
 	// loop through all vertices
-	for (int k = 0; k < vertices_num; k++) {
+	for (int k = 0; k < dist->n; k++) {
 		if ((k != v1) && (k != v2)) {
 			// distance from newly merged cluster to vertex k
-			double dist1 = dist[v1][k];
-			double dist2 = dist[v2][k];
+			Distance dist1 = *dist_cell(dist, v1, k);
+			Distance dist2 = *dist_cell(dist, v2, k);
+			Distance *merged = dist_cell(dist, new_cluster, k);
 			// if dist1 is INFINITY then we use the dist2 distance
 			if (dist1 == INFINITY) {
-				dist[new_cluster][k] = dist2;
-				dist[k][new_cluster] = dist2;
+				*merged = dist2;
 			}
 			// if dist2 is INFINTIY then we use the dist1 distance
 			else if (dist2 == INFINITY) {
-				dist[new_cluster][k] = dist1;
-				dist[k][new_cluster] = dist1;
+				*merged = dist1;
 			}
 			// IF LANCE WILLIAMS METHOD IS SINGLE LINKAGE
 			else if (method == SINGLE_LINKAGE) {
-				if (dist1 < dist2) {
-					// update dist for both sides 
-					dist[new_cluster][k] = dist1;
-					dist[k][new_cluster] = dist1;
-				}
-				// if dist1 is larger than or equal to dist2
-				else {
-					dist[new_cluster][k] = dist2;
-					dist[k][new_cluster] = dist2;
-				}
+				// one cell covers both sides of the matrix
+				*merged = dist1 < dist2 ? dist1 : dist2;
 			}
 			// IF LANCE WILLIAMS METHOD IS COMPLETE LINKAGE
 			else if (method == COMPLETE_LINKAGE) {
-				if (dist1 > dist2) {
-					dist[new_cluster][k] = dist1;
-					dist[k][new_cluster] = dist1;
-				}
-				// if dist1 is less than or equal to dist2
-				else {
-					dist[new_cluster][k] = dist2;
-					dist[k][new_cluster] = dist2;
-				}
+				*merged = dist1 > dist2 ? dist1 : dist2;
 			}
 		}
-		// v2 is now NULL after merging so we set both distances to INFINITY
-		dist[k][v2] = INFINITY;
-		dist[v2][k] = INFINITY;
+		// v2 is now NULL after merging so we set its distances to INFINITY
+		if (k != v2) {
+			*dist_cell(dist, k, v2) = INFINITY;
+		}
 	}
 }
 
-// find max weight of edges between vertex i and vertex j
-static double find_max_weight(Graph g, Vertex i, Vertex j) {
-	double a = 0;
-	double b = 0;
-	// create adjacency list of vertices coming out from i 
-	AdjList i_out = GraphOutIncident(g, i);
-	// loop through adjacency list of vertices going out of i and find j
-	while (i_out != NULL) {
-		if (i_out->v == j) {
-			a = i_out->weight;
-			break;
-		}
-		i_out = i_out->next;
+// builds the distance matrix: the distance between two vertices joined by
+// an edge in either direction is 1 / (max weight of those edges), and
+// INFINITY if there is no edge between them
+static void distance_matrix(GraphCSR csr, DistMatrix *dist) {
+	int vertices_num = csr->numNodes;
+	size_t cells_num = (size_t)vertices_num * (vertices_num - 1) / 2;
+	dist->n = vertices_num;
+	dist->cells = malloc((cells_num > 0 ? cells_num : 1) * sizeof(Distance));
+	assert(dist->cells != NULL);
+	for (size_t c = 0; c < cells_num; c++) {
+		dist->cells[c] = INFINITY;
 	}
-	// create adjacency list of vertices going into i 
-	AdjList i_in = GraphInIncident(g, i);
-	// loop through adjacency list of vertices going into i and find j
-	while (i_in != NULL) {
-		if (i_in->v == j) {
-			b = i_in->weight;
-			break;
+	// walk every edge once; 1/max(a, b) == min(1/a, 1/b), so keeping the
+	// smaller reciprocal over both directions gives the max weight rule
+	for (int i = 0; i < vertices_num; i++) {
+		for (int e = csr->outOffset[i]; e < csr->outOffset[i + 1]; e++) {
+			int j = csr->outVertex[e];
+			if (j == i) continue;
+			Distance edge_dist = (Distance)(1.0/csr->outWeight[e]);
+			Distance *cell = dist_cell(dist, i, j);
+			if (edge_dist < *cell) {
+				*cell = edge_dist;
+			}
 		}
-		i_in = i_in->next;
-	}
-	// if dist a is not reachable but b is reachable
-	if (a == INFINITY && b != INFINITY) {
-		return b;
-	}
-	// if dist b is reachable but a is not reachable
-	else if (a != INFINITY && b == INFINITY) {
-		return a;
 	}
-	else if (a > b) {
-		return a;
-	}
-	// if b > a or a == b
-	else {
-		return b;
+}
+
+// index of the first cell of row i (the distance from i to i + 1)
+static size_t row_offset(int n, int i) {
+	return (size_t)i * (2 * (size_t)n - i - 1) / 2;
+}
+
+// returns the cell holding the distance between clusters i and j (i != j)
+static Distance *dist_cell(DistMatrix *dist, int i, int j) {
+	if (i > j) {
+		int temp = i;
+		i = j;
+		j = temp;
 	}
+	return &dist->cells[row_offset(dist->n, i) + (j - i - 1)];
 }
 
 
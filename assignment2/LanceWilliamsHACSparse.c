@@ -0,0 +1,279 @@
+// Sparse single linkage clustering
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Single linkage clustering is Kruskal's algorithm: merging the closest pair
+// of clusters is the same as taking the next cheapest edge that joins two
+// different trees of the minimum spanning forest. This builds the same
+// dendrogram as LanceWilliamsHAC(g, SINGLE_LINKAGE) from the edge list alone,
+// using a union-find forest, in O(E log E) time and O(V + E) memory.
+//
+// Ties are broken the way the dense version breaks them. Among the pairs
+// at the current distance it merges the cluster with the lowest index (its
+// lowest vertex) with its lowest indexed neighbour, and keeps doing so until
+// that cluster has no neighbours left at this distance. So each group of
+// equal distance edges is processed as a min-label sweep: starting from the
+// lowest cluster, repeatedly absorb the lowest cluster adjacent to the ones
+// absorbed so far.
+
+#include <assert.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "GraphCSR.h"
+#include "LanceWilliamsHAC.h"
+#include "LanceWilliamsHACVariants.h"
+
+#define INFINITY DBL_MAX
+
+typedef struct Edge {
+	double dist;
+	int a;
+	int b;
+} Edge;
+
+typedef struct Forest {
+	int *parent;
+	int *lowest;       // lowest vertex in each tree, indexed by root
+	Dendrogram *cluster; // cluster of each tree, indexed by lowest vertex
+} Forest;
+
+// cluster adjacency within one group of equal distance edges
+typedef struct Link {
+	int from;
+	int to;
+} Link;
+
+//***********************FUNCTION DECLARATIONS**********************************
+static int collect_edges(GraphCSR csr, Edge *edges);
+static int edge_order(const void *a, const void *b);
+static int link_order(const void *a, const void *b);
+static int find_root(Forest *f, int v);
+static void merge_clusters(Forest *f, int low, int high);
+static void sweep_group(Forest *f, Edge *group, int group_num, Link *links,
+                        int *heap, int *stamp, int group_id);
+static void heap_push(int *heap, int *size, int item);
+static int heap_pop(int *heap, int *size);
+//******************************************************************************
+
+Dendrogram LanceWilliamsHACSparse(Graph g) {
+	GraphCSR csr = GraphCSRNewOut(g);
+	Dendrogram d = LanceWilliamsHACSparseCSR(csr);
+	GraphCSRFree(csr);
+	return d;
+}
+
+Dendrogram LanceWilliamsHACSparseCSR(GraphCSR csr) {
+	int vertices_num = csr->numNodes;
+	if (vertices_num == 0) {
+		return NULL;
+	}
+
+	// every edge with a usable distance, cheapest first
+	Edge *edges = malloc((csr->numEdges > 0 ? csr->numEdges : 1) * sizeof(Edge));
+	assert(edges != NULL);
+	int edges_num = collect_edges(csr, edges);
+	qsort(edges, edges_num, sizeof(Edge), edge_order);
+
+	Forest f;
+	f.parent = malloc(vertices_num * sizeof(int));
+	f.lowest = malloc(vertices_num * sizeof(int));
+	f.cluster = malloc(vertices_num * sizeof(Dendrogram));
+	assert(f.parent != NULL && f.lowest != NULL && f.cluster != NULL);
+	for (int v = 0; v < vertices_num; v++) {
+		f.parent[v] = v;
+		f.lowest[v] = v;
+		f.cluster[v] = malloc(sizeof(DNode));
+		assert(f.cluster[v] != NULL);
+		f.cluster[v]->vertex = v;
+		f.cluster[v]->left = NULL;
+		f.cluster[v]->right = NULL;
+	}
+
+	// scratch space for the groups, each at most edges_num edges
+	Link *links = malloc((2 * edges_num > 0 ? 2 * edges_num : 1) * sizeof(Link));
+	int *heap = malloc((2 * edges_num > 0 ? 2 * edges_num : 1) * sizeof(int));
+	int *stamp = malloc(vertices_num * sizeof(int));
+	assert(links != NULL && heap != NULL && stamp != NULL);
+	for (int v = 0; v < vertices_num; v++) {
+		stamp[v] = -1;
+	}
+
+	// merge one group of equal distance edges at a time
+	int group_id = 0;
+	for (int start = 0; start < edges_num; group_id++) {
+		int end = start + 1;
+		while (end < edges_num && edges[end].dist == edges[start].dist) {
+			end++;
+		}
+		sweep_group(&f, &edges[start], end - start, links, heap, stamp, group_id);
+		start = end;
+	}
+
+	// clusters with no edges between them are merged lowest index first,
+	// as the dense version does once no finite distances are left
+	int first = f.lowest[find_root(&f, 0)];
+	for (int v = 1; v < vertices_num; v++) {
+		int root = find_root(&f, v);
+		if (f.lowest[root] == v) {
+			merge_clusters(&f, first, v);
+		}
+	}
+	Dendrogram final_cluster = f.cluster[first];
+
+	free(edges);
+	free(links);
+	free(heap);
+	free(stamp);
+	free(f.parent);
+	free(f.lowest);
+	free(f.cluster);
+	return final_cluster;
+}
+
+// stores every edge between two different vertices as a distance of
+// 1 / weight. Both directions of a pair are kept; the cheaper one joins the
+// pair first and the other is skipped since they are already merged by then.
+static int collect_edges(GraphCSR csr, Edge *edges) {
+	int edges_num = 0;
+	for (int i = 0; i < csr->numNodes; i++) {
+		for (int e = csr->outOffset[i]; e < csr->outOffset[i + 1]; e++) {
+			int j = csr->outVertex[e];
+			double dist = 1.0/csr->outWeight[e];
+			// same test the dense version uses when picking a pair
+			if (j == i || !(dist > 0 && dist < INFINITY)) continue;
+			edges[edges_num].dist = dist;
+			edges[edges_num].a = i < j ? i : j;
+			edges[edges_num].b = i < j ? j : i;
+			edges_num++;
+		}
+	}
+	return edges_num;
+}
+
+// merges every pair of clusters joined by an edge in the group, in the same
+// order the dense version would merge them
+static void sweep_group(Forest *f, Edge *group, int group_num, Link *links,
+                        int *heap, int *stamp, int group_id) {
+	// adjacency between the clusters (named by lowest vertex) at the start
+	// of the group
+	int links_num = 0;
+	for (int i = 0; i < group_num; i++) {
+		int low_a = f->lowest[find_root(f, group[i].a)];
+		int low_b = f->lowest[find_root(f, group[i].b)];
+		if (low_a == low_b) continue;
+		links[links_num++] = (Link){low_a, low_b};
+		links[links_num++] = (Link){low_b, low_a};
+	}
+	qsort(links, links_num, sizeof(Link), link_order);
+
+	// sweep each connected set of clusters, starting from its lowest cluster
+	for (int i = 0; i < links_num; i++) {
+		int start = links[i].from;
+		if (stamp[start] == group_id) continue;
+		stamp[start] = group_id;
+
+		int heap_size = 0;
+		int pos = i;
+		while (pos < links_num && links[pos].from == start) {
+			heap_push(heap, &heap_size, links[pos++].to);
+		}
+		while (heap_size > 0) {
+			int next = heap_pop(heap, &heap_size);
+			if (stamp[next] == group_id) continue;
+			stamp[next] = group_id;
+			merge_clusters(f, start, next);
+
+			// queue the neighbours of the cluster just absorbed; its links
+			// start at the first link from `next`
+			int lo = 0;
+			int hi = links_num;
+			while (lo < hi) {
+				int mid = (lo + hi) / 2;
+				if (links[mid].from < next) {
+					lo = mid + 1;
+				}
+				else {
+					hi = mid;
+				}
+			}
+			for (pos = lo; pos < links_num && links[pos].from == next; pos++) {
+				if (stamp[links[pos].to] != group_id) {
+					heap_push(heap, &heap_size, links[pos].to);
+				}
+			}
+		}
+	}
+}
+
+static int edge_order(const void *a, const void *b) {
+	const Edge *edge_1 = a;
+	const Edge *edge_2 = b;
+	if (edge_1->dist < edge_2->dist) return -1;
+	if (edge_1->dist > edge_2->dist) return 1;
+	return 0;
+}
+
+static int link_order(const void *a, const void *b) {
+	const Link *link_1 = a;
+	const Link *link_2 = b;
+	if (link_1->from != link_2->from) {
+		return link_1->from - link_2->from;
+	}
+	return link_1->to - link_2->to;
+}
+
+// finds the root of the tree containing v, halving the path on the way
+static int find_root(Forest *f, int v) {
+	while (f->parent[v] != v) {
+		f->parent[v] = f->parent[f->parent[v]];
+		v = f->parent[v];
+	}
+	return v;
+}
+
+// merges the cluster with lowest vertex `high` into the cluster with lowest
+// vertex `low` (low < high); the lower cluster becomes the left child
+static void merge_clusters(Forest *f, int low, int high) {
+	Dendrogram new_cluster = malloc(sizeof(*new_cluster));
+	assert(new_cluster != NULL);
+	new_cluster->vertex = -1;
+	new_cluster->left = f->cluster[low];
+	new_cluster->right = f->cluster[high];
+	f->cluster[low] = new_cluster;
+	f->cluster[high] = NULL;
+
+	int root_low = find_root(f, low);
+	int root_high = find_root(f, high);
+	f->parent[root_high] = root_low;
+	f->lowest[root_low] = low;
+}
+
+static void heap_push(int *heap, int *size, int item) {
+	int i = (*size)++;
+	heap[i] = item;
+	while (i > 0 && heap[(i - 1) / 2] > heap[i]) {
+		int temp = heap[i];
+		heap[i] = heap[(i - 1) / 2];
+		heap[(i - 1) / 2] = temp;
+		i = (i - 1) / 2;
+	}
+}
+
+static int heap_pop(int *heap, int *size) {
+	int top = heap[0];
+	heap[0] = heap[--(*size)];
+	int i = 0;
+	while (2 * i + 1 < *size) {
+		int child = 2 * i + 1;
+		if (child + 1 < *size && heap[child + 1] < heap[child]) {
+			child++;
+		}
+		if (heap[i] <= heap[child]) break;
+		int temp = heap[i];
+		heap[i] = heap[child];
+		heap[child] = temp;
+		i = child;
+	}
+	return top;
+}
@@ -0,0 +1,31 @@
+// Lance-Williams HAC API extensions
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Versions of LanceWilliamsHAC that read a prebuilt graph snapshot. The
+// returned Dendrogram is released with freeDendrogram().
+
+#ifndef LANCE_WILLIAMS_HAC_VARIANTS_H
+#define LANCE_WILLIAMS_HAC_VARIANTS_H
+
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "LanceWilliamsHAC.h"
+
+/**
+ * Same as LanceWilliamsHAC, reading the edges from a snapshot.
+ */
+Dendrogram LanceWilliamsHACCSR(GraphCSR csr, int method);
+
+/**
+ * Generates the same Dendrogram as LanceWilliamsHAC(g, SINGLE_LINKAGE)
+ * from a minimum spanning forest of the edges, without building the V x V
+ * distance matrix. Runs in O(E log E) time and O(V + E) memory.
+ */
+Dendrogram LanceWilliamsHACSparse(Graph g);
+
+/**
+ * Same as LanceWilliamsHACSparse, reading the edges from a snapshot.
+ */
+Dendrogram LanceWilliamsHACSparseCSR(GraphCSR csr);
+
+#endif
@@ -0,0 +1,250 @@
+// Parallel Centrality Measures API implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Sources are cut into CHUNKS_PER_THREAD chunks per worker.
+//
+// For closeness each worker starts on its own contiguous run of chunks and,
+// once that run is empty, steals chunks from the other workers' runs.
+// Claiming a chunk is a single atomic increment on the owning run, so
+// owners and thieves never clash. Each source's value is written straight
+// to its own slot, so the schedule can't change the result.
+//
+// For betweenness each worker adds into one partial array of its own, so
+// which partial a chunk lands in has to be fixed for the sum to be
+// reproducible: worker t takes chunks t, t + T, t + 2T, ... (T workers) in
+// that order, which spreads neighbouring (similar cost) chunks over the
+// workers instead of stealing. The workers then reduce the partials in
+// parallel, each summing its own slice of the vertices over the partials
+// in worker order, so the result for a given thread count never depends
+// on how the threads happened to be scheduled.
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "CentralityEngine.h"
+#include "Dijkstra.h"
+#include "DijkstraWorkspace.h"
+#include "GraphCSR.h"
+#include "ParallelCentrality.h"
+
+#define CHUNKS_PER_THREAD 16
+
+typedef enum { CLOSENESS, BETWEENNESS } Measure;
+
+// a run of chunks owned by one worker, [next, end)
+struct ChunkRun {
+	atomic_int next;
+	int end;
+};
+
+struct CentralityJob {
+	GraphCSR csr;            // snapshot shared read-only by every worker
+	Measure measure;
+	int numNodes;
+	int numThreads;
+	int numChunks;
+	struct ChunkRun *runs;   // one run per worker
+	double *values;          // closeness results, one per source
+	double **partials;       // betweenness partials, one array per worker
+};
+
+struct Worker {
+	struct CentralityJob *job;
+	int id;
+};
+
+//***********************FUNCTION DECLARATIONS**********************************
+static NodeValues run_job(Graph g, Measure measure, int numThreads);
+static void run_workers(struct CentralityJob *job, void *(*work)(void *));
+static void *worker_main(void *arg);
+static void *reduce_main(void *arg);
+static int claim_chunk(struct CentralityJob *job, int id);
+static void process_chunk(struct CentralityJob *job, int chunk,
+                          DijkstraWorkspace ws, BrandesScratch bs,
+                          double *partial);
+//******************************************************************************
+
+int centralityThreadCount(int requested) {
+	if (requested > 0) {
+		return requested;
+	}
+	char *env = getenv(CENTRALITY_THREADS_ENV);
+	if (env != NULL && atoi(env) > 0) {
+		return atoi(env);
+	}
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	return cpus > 0 ? (int)cpus : 1;
+}
+
+NodeValues closenessCentralityParallel(Graph g, int numThreads) {
+	return run_job(g, CLOSENESS, numThreads);
+}
+
+NodeValues betweennessCentralityParallel(Graph g, int numThreads) {
+	return run_job(g, BETWEENNESS, numThreads);
+}
+
+NodeValues betweennessCentralityNormalisedParallel(Graph g, int numThreads) {
+	NodeValues nvs = betweennessCentralityParallel(g, numThreads);
+	for (int i = 0; i < nvs.numNodes; i++) {
+		nvs.values[i] = betweennessNormalise(nvs.numNodes, nvs.values[i]);
+	}
+	return nvs;
+}
+
+// spreads the sources over the workers, waits for them and reduces the
+// per-worker partials
+static NodeValues run_job(Graph g, Measure measure, int numThreads) {
+	struct CentralityJob job = {0};
+	job.csr = GraphCSRNewOut(g);
+	job.measure = measure;
+	job.numNodes = GraphNumVertices(g);
+	job.numThreads = centralityThreadCount(numThreads);
+	job.numChunks = job.numThreads * CHUNKS_PER_THREAD;
+	if (job.numChunks > job.numNodes) {
+		job.numChunks = job.numNodes > 0 ? job.numNodes : 1;
+	}
+	if (job.numThreads > job.numChunks) {
+		job.numThreads = job.numChunks;
+	}
+
+	NodeValues nvs = {0};
+	nvs.numNodes = job.numNodes;
+	nvs.values = calloc(job.numNodes > 0 ? job.numNodes : 1, sizeof(double));
+	assert(nvs.values != NULL);
+	job.values = nvs.values;
+	if (measure == BETWEENNESS) {
+		job.partials = malloc(job.numThreads * sizeof(double *));
+		assert(job.partials != NULL);
+		for (int t = 0; t < job.numThreads; t++) {
+			job.partials[t] = calloc(job.numNodes > 0 ? job.numNodes : 1,
+			                         sizeof(double));
+			assert(job.partials[t] != NULL);
+		}
+	}
+
+	// hand each worker a contiguous run of chunks
+	job.runs = malloc(job.numThreads * sizeof(struct ChunkRun));
+	assert(job.runs != NULL);
+	for (int t = 0; t < job.numThreads; t++) {
+		atomic_init(&job.runs[t].next, t * job.numChunks / job.numThreads);
+		job.runs[t].end = (t + 1) * job.numChunks / job.numThreads;
+	}
+
+	run_workers(&job, worker_main);
+	if (measure == BETWEENNESS) {
+		run_workers(&job, reduce_main);
+		for (int t = 0; t < job.numThreads; t++) {
+			free(job.partials[t]);
+		}
+		free(job.partials);
+	}
+	GraphCSRFree(job.csr);
+	free(job.runs);
+	return nvs;
+}
+
+// starts one thread per worker on the given function and waits for them
+static void run_workers(struct CentralityJob *job, void *(*work)(void *)) {
+	pthread_t *threads = malloc(job->numThreads * sizeof(pthread_t));
+	struct Worker *workers = malloc(job->numThreads * sizeof(struct Worker));
+	assert(threads != NULL && workers != NULL);
+	for (int t = 0; t < job->numThreads; t++) {
+		workers[t].job = job;
+		workers[t].id = t;
+		if (pthread_create(&threads[t], NULL, work, &workers[t]) != 0) {
+			fprintf(stderr, "Can't create centrality worker thread\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	for (int t = 0; t < job->numThreads; t++) {
+		pthread_join(threads[t], NULL);
+	}
+	free(threads);
+	free(workers);
+}
+
+// runs the worker's share of the chunks: for closeness it claims chunks
+// (own run first, then steals) until none are left, for betweenness it
+// takes every numThreads-th chunk
+static void *worker_main(void *arg) {
+	struct Worker *worker = arg;
+	struct CentralityJob *job = worker->job;
+	// each worker keeps its own buffers for every source it runs
+	DijkstraWorkspace ws = dijkstraWorkspaceNew(job->numNodes);
+	BrandesScratch bs = NULL;
+	if (job->measure == BETWEENNESS) {
+		bs = brandesScratchNew(job->numNodes);
+	}
+
+	if (job->measure == CLOSENESS) {
+		int chunk;
+		while ((chunk = claim_chunk(job, worker->id)) != -1) {
+			process_chunk(job, chunk, ws, bs, NULL);
+		}
+	}
+	else {
+		double *partial = job->partials[worker->id];
+		for (int chunk = worker->id; chunk < job->numChunks;
+		     chunk += job->numThreads) {
+			process_chunk(job, chunk, ws, bs, partial);
+		}
+	}
+
+	if (bs != NULL) {
+		brandesScratchFree(bs);
+	}
+	dijkstraWorkspaceFree(ws);
+	return NULL;
+}
+
+// adds up the partials for the worker's slice of the vertices, in worker
+// order
+static void *reduce_main(void *arg) {
+	struct Worker *worker = arg;
+	struct CentralityJob *job = worker->job;
+	int first = (int)((long)worker->id * job->numNodes / job->numThreads);
+	int last = (int)((long)(worker->id + 1) * job->numNodes / job->numThreads);
+	for (int t = 0; t < job->numThreads; t++) {
+		double *partial = job->partials[t];
+		for (int v = first; v < last; v++) {
+			job->values[v] += partial[v];
+		}
+	}
+	return NULL;
+}
+
+// returns the next unprocessed chunk, or -1 if every run is exhausted
+static int claim_chunk(struct CentralityJob *job, int id) {
+	for (int i = 0; i < job->numThreads; i++) {
+		struct ChunkRun *run = &job->runs[(id + i) % job->numThreads];
+		if (atomic_load(&run->next) >= run->end) continue;
+		int chunk = atomic_fetch_add(&run->next, 1);
+		if (chunk < run->end) {
+			return chunk;
+		}
+	}
+	return -1;
+}
+
+// runs every source in the given chunk, adding betweenness into `partial`
+static void process_chunk(struct CentralityJob *job, int chunk,
+                          DijkstraWorkspace ws, BrandesScratch bs,
+                          double *partial) {
+	int first = (int)((long)chunk * job->numNodes / job->numChunks);
+	int last = (int)((long)(chunk + 1) * job->numNodes / job->numChunks);
+
+	for (int src = first; src < last; src++) {
+		dijkstraCSRInto(job->csr, src, ws);
+		if (job->measure == CLOSENESS) {
+			job->values[src] = closenessFromWorkspace(ws);
+		}
+		else {
+			brandesAccumulateWorkspace(ws, bs, partial);
+		}
+	}
+}
@@ -0,0 +1,43 @@
+// Parallel Centrality Measures API
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Multi-threaded versions of the all-sources centrality measures. Source
+// vertices are split into chunks which are shared out among worker threads
+// until every source has been processed.
+
+#ifndef PARALLEL_CENTRALITY_H
+#define PARALLEL_CENTRALITY_H
+
+#include "CentralityMeasures.h"
+#include "Graph.h"
+
+// environment variable consulted when no thread count is given
+#define CENTRALITY_THREADS_ENV "CENTRALITY_THREADS"
+
+/**
+ * Returns the number of worker threads to use. A positive `requested`
+ * value is used as is, otherwise the CENTRALITY_THREADS environment
+ * variable is consulted, falling back to the number of online CPUs.
+ */
+int centralityThreadCount(int requested);
+
+/**
+ * Same  as  closenessCentrality,  using  the given number of threads (see
+ * centralityThreadCount for how `numThreads` <= 0 is resolved).
+ */
+NodeValues closenessCentralityParallel(Graph g, int numThreads);
+
+/**
+ * Same as betweennessCentrality, using the given number of threads. The
+ * result  is  deterministic:  each  thread keeps one partial sum for a
+ * fixed set of sources, and the partials are reduced in a fixed order.
+ */
+NodeValues betweennessCentralityParallel(Graph g, int numThreads);
+
+/**
+ * Same  as  betweennessCentralityNormalised, using the given number of
+ * threads.
+ */
+NodeValues betweennessCentralityNormalisedParallel(Graph g, int numThreads);
+
+#endif
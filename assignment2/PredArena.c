@@ -0,0 +1,119 @@
+// Predecessor list arena implementation
+// COMP2521 Assignment 2
+// James Teng z5361442
+// The arena header sits directly in front of the pred array handed out to
+// callers, so a ShortestPaths structure needs no extra field to find it.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Dijkstra.h"
+#include "PredArena.h"
+
+#define MIN_SLAB_NODES 64
+
+struct PredSlab {
+	struct PredSlab *next;
+	int capacity;
+	PredNode nodes[];
+};
+
+struct PredArena {
+	struct PredSlab *first;  // every slab, in allocation order
+	struct PredSlab *curr;   // slab currently being carved up
+	int used;                // nodes handed out from curr
+	int numNodes;
+};
+
+//***********************FUNCTION DECLARATIONS**********************************
+static struct PredArena *arena_of(PredNode **pred);
+static PredNode *arena_alloc(struct PredArena *arena);
+static struct PredSlab *slab_new(int capacity);
+//******************************************************************************
+
+PredNode **predArrayNew(int numNodes) {
+	struct PredArena *arena = malloc(sizeof(*arena) + numNodes * sizeof(PredNode *));
+	assert(arena != NULL);
+	arena->first = arena->curr = NULL;
+	arena->used = 0;
+	arena->numNodes = numNodes;
+	PredNode **pred = (PredNode **)(arena + 1);
+	for (int i = 0; i < numNodes; i++) {
+		pred[i] = NULL;
+	}
+	return pred;
+}
+
+void predArrayFree(PredNode **pred) {
+	if (pred == NULL) return;
+	struct PredArena *arena = arena_of(pred);
+	struct PredSlab *slab = arena->first;
+	while (slab != NULL) {
+		struct PredSlab *temp = slab;
+		slab = slab->next;
+		free(temp);
+	}
+	free(arena);
+}
+
+void predArrayPush(PredNode **pred, Vertex v, Vertex u) {
+	PredNode *new_head = arena_alloc(arena_of(pred));
+	new_head->v = u;
+	new_head->next = pred[v];
+	pred[v] = new_head;
+}
+
+void predArraySet(PredNode **pred, Vertex v, Vertex u) {
+	PredNode *node = arena_alloc(arena_of(pred));
+	node->v = u;
+	node->next = NULL;
+	pred[v] = node;
+}
+
+void predArrayReset(PredNode **pred) {
+	struct PredArena *arena = arena_of(pred);
+	arena->curr = arena->first;
+	arena->used = 0;
+}
+
+// recovers the arena header stored in front of a pred array
+static struct PredArena *arena_of(PredNode **pred) {
+	return (struct PredArena *)pred - 1;
+}
+
+// hands out the next free node, moving on to (or creating) the next slab
+// when the current one is full
+static PredNode *arena_alloc(struct PredArena *arena) {
+	if (arena->curr == NULL || arena->used == arena->curr->capacity) {
+		if (arena->curr != NULL && arena->curr->next != NULL) {
+			// reuse a slab kept from before the last reset
+			arena->curr = arena->curr->next;
+		}
+		else {
+			// each new slab doubles the space in the arena
+			int capacity = arena->numNodes > MIN_SLAB_NODES ? arena->numNodes : MIN_SLAB_NODES;
+			if (arena->curr != NULL) {
+				capacity = arena->curr->capacity * 2;
+			}
+			struct PredSlab *slab = slab_new(capacity);
+			if (arena->curr == NULL) {
+				arena->first = slab;
+			}
+			else {
+				arena->curr->next = slab;
+			}
+			arena->curr = slab;
+		}
+		arena->used = 0;
+	}
+	return &arena->curr->nodes[arena->used++];
+}
+
+static struct PredSlab *slab_new(int capacity) {
+	struct PredSlab *slab = malloc(sizeof(*slab) + capacity * sizeof(PredNode));
+	assert(slab != NULL);
+	slab->next = NULL;
+	slab->capacity = capacity;
+	return slab;
+}
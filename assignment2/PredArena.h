@@ -0,0 +1,43 @@
+// Predecessor list arena interface
+// COMP2521 Assignment 2
+// James Teng z5361442
+// Allocates the `pred` array of a ShortestPaths structure together with a
+// slab allocator for its PredNodes. The array is still a plain array of
+// PredNode linked lists, so callers walk pred[v] exactly as before, but
+// nodes are carved out of large slabs instead of being malloc'd one at a
+// time, and the whole lot is released with a single predArrayFree().
+
+#ifndef PRED_ARENA_H
+#define PRED_ARENA_H
+
+#include "Dijkstra.h"
+
+/**
+ * Returns a new array of numNodes empty predecessor lists.
+ */
+PredNode **predArrayNew(int numNodes);
+
+/**
+ * Frees the array and every PredNode allocated for it.
+ */
+void predArrayFree(PredNode **pred);
+
+/**
+ * Adds `u` to the front of the predecessor list of `v`.
+ */
+void predArrayPush(PredNode **pred, Vertex v, Vertex u);
+
+/**
+ * Replaces the predecessor list of `v` with the single vertex `u`. The
+ * old nodes stay in the arena until the next reset.
+ */
+void predArraySet(PredNode **pred, Vertex v, Vertex u);
+
+/**
+ * Releases every PredNode back to the arena in O(1). The lists in
+ * `pred` are left dangling; the caller must set every list it will read
+ * again back to NULL.
+ */
+void predArrayReset(PredNode **pred);
+
+#endif
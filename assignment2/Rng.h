@@ -0,0 +1,41 @@
+// Small seeded random number generator
+// COMP2521 Assignment 2
+// James Teng z5361442
+// The approximate centrality measures and the benchmark generators must
+// give the same results for the same seed on every machine, so they use
+// this (splitmix64) instead of rand(), whose sequence differs between C
+// libraries.
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+typedef struct Rng {
+	uint64_t state;
+} Rng;
+
+static inline Rng RngNew(uint64_t seed) {
+	Rng r = { seed };
+	return r;
+}
+
+// Returns the next 64 random bits
+static inline uint64_t RngNext(Rng *r) {
+	uint64_t z = (r->state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// Returns a double in [0, 1)
+static inline double RngDouble(Rng *r) {
+	return (RngNext(r) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Returns an int in [0, n); the bias is negligible for the n used here
+static inline int RngInt(Rng *r, int n) {
+	return (int)(((RngNext(r) >> 32) * (uint64_t)n) >> 32);
+}
+
+#endif
@@ -0,0 +1,106 @@
+// COMP2521 benchmarks
+// BenchReport.c ... implementation of the benchmark timer and result writer
+// z5361442 James Teng
+/* Results are written as soon as they are added, so a long suite that is
+interrupted still leaves the finished benchmarks behind (in JSON the closing
+brackets are only written by BenchReportFree). Names and params are written
+as given; they are expected not to need quoting. */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "BenchReport.h"
+
+struct BenchReportRep {
+	FILE *out;
+	ReportFormat format;
+	const char *suite;
+	int results;              // results written so far
+};
+
+// ************************ function prototypes ********************************
+static int compare_doubles(const void *a, const void *b);
+// ************************ end of function prototypes *************************
+
+int ReportFormatFromName(const char *name) {
+	if (strcmp(name, "csv") == 0) return REPORT_CSV;
+	if (strcmp(name, "json") == 0) return REPORT_JSON;
+	return -1;
+}
+
+BenchReport BenchReportNew(FILE *out, ReportFormat format, const char *suite) {
+	BenchReport r = malloc(sizeof(struct BenchReportRep));
+	assert(r != NULL);
+	r->out = out;
+	r->format = format;
+	r->suite = suite;
+	r->results = 0;
+	if (format == REPORT_CSV) {
+		fprintf(out, "suite,benchmark,params,items,reps,"
+		             "min_s,median_s,mean_s,items_per_s\n");
+	}
+	else {
+		fprintf(out, "{\n  \"suite\": \"%s\",\n  \"results\": [", suite);
+	}
+	fflush(out);
+	return r;
+}
+
+void BenchReportFree(BenchReport r) {
+	if (r->format == REPORT_JSON) {
+		fprintf(r->out, "%s]\n}\n", r->results > 0 ? "\n  " : "");
+	}
+	fflush(r->out);
+	free(r);
+}
+
+void BenchReportAdd(BenchReport r, const char *benchmark, const char *params,
+                    long items, int reps, double *seconds) {
+	assert(reps > 0);
+	qsort(seconds, reps, sizeof(double), compare_doubles);
+	double total = 0;
+	for (int i = 0; i < reps; i++) {
+		total += seconds[i];
+	}
+	double min = seconds[0];
+	double median = reps % 2 == 1
+	              ? seconds[reps / 2]
+	              : (seconds[reps / 2 - 1] + seconds[reps / 2]) / 2;
+	double mean = total / reps;
+	double rate = median > 0 ? items / median : 0;
+
+	if (r->format == REPORT_CSV) {
+		fprintf(r->out, "%s,%s,%s,%ld,%d,%.9f,%.9f,%.9f,%.1f\n",
+		        r->suite, benchmark, params, items, reps,
+		        min, median, mean, rate);
+	}
+	else {
+		fprintf(r->out, "%s\n    {\"benchmark\": \"%s\", \"params\": \"%s\", "
+		        "\"items\": %ld, \"reps\": %d, \"min_s\": %.9f, "
+		        "\"median_s\": %.9f, \"mean_s\": %.9f, \"items_per_s\": %.1f}",
+		        r->results > 0 ? "," : "", benchmark, params, items, reps,
+		        min, median, mean, rate);
+	}
+	r->results++;
+	fflush(r->out);
+}
+
+double BenchNow(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+static int compare_doubles(const void *a, const void *b) {
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
@@ -0,0 +1,47 @@
+// COMP2521 benchmarks
+// BenchReport.h ... interface to the benchmark timer and result writer
+// z5361442 James Teng
+// Each benchmark is run a number of times; the report keeps the fastest,
+// median and mean time of the runs and writes one record per benchmark as
+// CSV (with a header line) or as a JSON document. Times are wall-clock
+// seconds from a monotonic clock.
+//
+// CSV columns, and the fields of each JSON result:
+//   suite, benchmark, params, items, reps, min_s, median_s, mean_s,
+//   items_per_s
+// `items` is how many operations one run does (words inserted, sources
+// searched, ...), so items_per_s = items / median_s. `params` is a
+// "key=value key=value" string describing the input.
+
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include <stdio.h>
+
+typedef enum {
+	REPORT_CSV,
+	REPORT_JSON,
+} ReportFormat;
+
+typedef struct BenchReportRep *BenchReport;
+
+// Returns the format with the given name ("csv" or "json"), or -1 if there
+// is no such format
+int ReportFormatFromName(const char *name);
+
+// Starts a report for the given suite, written to `out` as results are
+// added
+BenchReport BenchReportNew(FILE *out, ReportFormat format, const char *suite);
+
+// Finishes the report and frees it
+void BenchReportFree(BenchReport r);
+
+// Records a benchmark given the times of its `reps` runs (which may be
+// reordered)
+void BenchReportAdd(BenchReport r, const char *benchmark, const char *params,
+                    long items, int reps, double *seconds);
+
+// Returns the current time in seconds; only differences are meaningful
+double BenchNow(void);
+
+#endif
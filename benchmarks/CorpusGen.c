@@ -0,0 +1,164 @@
+// COMP2521 benchmarks
+// CorpusGen.c ... implementation of the synthetic text generator
+// z5361442 James Teng
+/* Ranks are sampled by binary search over the cumulative distribution. A
+word is made of two-letter syllables (a consonant then a vowel, so 100 of
+them): ranks 0-99 are one syllable, the next 10000 two syllables and so on,
+so frequent words are short as in real text. Within a length the ranks are
+shuffled by a multiplication that is invertible modulo 100^k, which keeps
+every word distinct without storing the vocabulary. */
+
+#include <assert.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CorpusGen.h"
+#include "Rng.h"
+
+#define LINE_WIDTH 72
+#define SHUFFLE 7919          // coprime to 100, so a bijection mod 100^k
+
+struct ZipfRep {
+	int vocab;
+	double *cdf;              // cdf[r] = P(rank <= r)
+};
+
+static const char consonants[] = "bcdfghjklmnprstvwxyz";
+static const char vowels[] = "aeiou";
+
+// ************************ function prototypes ********************************
+static void emit_word(FILE *out, const char *word, int length, int *column);
+// ************************ end of function prototypes *************************
+
+Zipf ZipfNew(int vocab, double exponent) {
+	assert(vocab > 0);
+	Zipf z = malloc(sizeof(struct ZipfRep));
+	assert(z != NULL);
+	z->vocab = vocab;
+	z->cdf = malloc(vocab * sizeof(double));
+	assert(z->cdf != NULL);
+	double total = 0;
+	for (int r = 0; r < vocab; r++) {
+		total += pow(r + 1, -exponent);
+		z->cdf[r] = total;
+	}
+	for (int r = 0; r < vocab; r++) {
+		z->cdf[r] /= total;
+	}
+	z->cdf[vocab - 1] = 1.0;
+	return z;
+}
+
+void ZipfFree(Zipf z) {
+	free(z->cdf);
+	free(z);
+}
+
+int ZipfSample(Zipf z, Rng *r) {
+	double u = RngDouble(r);
+	// first rank whose cumulative probability exceeds u
+	int lo = 0;
+	int hi = z->vocab - 1;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (z->cdf[mid] > u) {
+			hi = mid;
+		}
+		else {
+			lo = mid + 1;
+		}
+	}
+	return lo;
+}
+
+int VocabWord(int rank, char *buf) {
+	assert(rank >= 0 && rank < VOCAB_MAX);
+	// find how many syllables, and the rank among words of that length
+	int syllables = 1;
+	int64_t words = 100;
+	int64_t index = rank;
+	while (index >= words) {
+		index -= words;
+		words *= 100;
+		syllables++;
+	}
+	index = index * SHUFFLE % words;
+	int length = 0;
+	for (int i = 0; i < syllables; i++) {
+		int syllable = index % 100;
+		index /= 100;
+		buf[length++] = consonants[syllable / 5];
+		buf[length++] = vowels[syllable % 5];
+	}
+	buf[length] = '\0';
+	return length;
+}
+
+void GenerateCorpus(FILE *out, long words, int vocab, double exponent,
+                    uint64_t seed) {
+	Rng r = RngNew(seed);
+	Zipf z = ZipfNew(vocab, exponent);
+
+	fprintf(out, "The Project Gutenberg EBook of Synthetic Text %llu\n\n",
+	        (unsigned long long)seed);
+	fprintf(out, "Words: %ld, vocabulary: %d, Zipf exponent: %g\n\n",
+	        words, vocab, exponent);
+	fprintf(out, "*** START OF THIS PROJECT GUTENBERG EBOOK SYNTHETIC ***\n\n");
+
+	char word[VOCAB_WORD_MAX + 2];
+	int column = 0;
+	int sentence_left = 0;    // words left in the current sentence
+	int paragraph_left = 0;   // sentences left in the current paragraph
+	for (long i = 0; i < words; i++) {
+		bool first = sentence_left == 0;
+		if (first) {
+			sentence_left = 5 + RngInt(&r, 16);
+			if (paragraph_left == 0) {
+				paragraph_left = 3 + RngInt(&r, 6);
+			}
+		}
+		int length = VocabWord(ZipfSample(z, &r), word);
+		if (first) {
+			word[0] = toupper((unsigned char)word[0]);
+		}
+		sentence_left--;
+		if (sentence_left == 0 || i == words - 1) {
+			word[length++] = ".......?!?"[RngInt(&r, 10)];
+		}
+		else if (RngInt(&r, 10) == 0) {
+			word[length++] = ',';
+		}
+		word[length] = '\0';
+		emit_word(out, word, length, &column);
+		if (sentence_left == 0 && --paragraph_left == 0) {
+			fputs("\n\n", out);
+			column = 0;
+		}
+	}
+	if (column > 0) {
+		fputc('\n', out);
+	}
+
+	fprintf(out, "\n*** END OF THIS PROJECT GUTENBERG EBOOK SYNTHETIC ***\n");
+	ZipfFree(z);
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// writes a word, wrapping the line before it if it would not fit
+static void emit_word(FILE *out, const char *word, int length, int *column) {
+	if (*column > 0 && *column + 1 + length > LINE_WIDTH) {
+		fputc('\n', out);
+		*column = 0;
+	}
+	if (*column > 0) {
+		fputc(' ', out);
+		(*column)++;
+	}
+	fputs(word, out);
+	*column += length;
+}
@@ -0,0 +1,45 @@
+// COMP2521 benchmarks
+// CorpusGen.h ... interface to the synthetic text generator
+// z5361442 James Teng
+// Word frequencies in real books roughly follow Zipf's law: the word of
+// rank r turns up in proportion to 1 / r^s, with s a little above 1. The
+// generator draws words that way from a made-up vocabulary and lays them
+// out like a Project Gutenberg book, so tw can read its output directly.
+// The same arguments always produce the same text.
+
+#ifndef CORPUS_GEN_H
+#define CORPUS_GEN_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Rng.h"
+
+// longest word VocabWord can produce
+#define VOCAB_WORD_MAX 8
+// largest vocabulary VocabWord can name
+#define VOCAB_MAX 10000000
+
+typedef struct ZipfRep *Zipf;
+
+// Creates a sampler over ranks 0..vocab-1 with the given exponent (s)
+Zipf ZipfNew(int vocab, double exponent);
+
+// Frees the given sampler
+void ZipfFree(Zipf z);
+
+// Returns a random rank; rank 0 is the most frequent
+int ZipfSample(Zipf z, Rng *r);
+
+// Writes the (lowercase) word of the given rank into `buf`, which must
+// have room for VOCAB_WORD_MAX + 1 characters, and returns its length.
+// Different ranks give different words, and lower ranks give words no
+// longer than higher ranks.
+int VocabWord(int rank, char *buf);
+
+// Writes a book of `words` words drawn from a vocabulary of `vocab` words
+// with Zipf exponent `exponent`, with a Gutenberg header and footer
+void GenerateCorpus(FILE *out, long words, int vocab, double exponent,
+                    uint64_t seed);
+
+#endif
@@ -0,0 +1,170 @@
+// COMP2521 benchmarks
+// GraphGen.c ... implementation of the synthetic graph generators
+// z5361442 James Teng
+/* Erdős–Rényi graphs skip ahead over the pairs that are not edges, drawing
+the gap to the next edge from a geometric distribution, so building one takes
+time proportional to its edges rather than nV^2. Chung–Lu graphs draw both
+ends of each edge in proportion to the vertex weights (by binary search over
+their running sums); repeated edges and self loops are dropped, so there can
+be slightly fewer edges than asked for. */
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Graph.h"
+#include "GraphGen.h"
+#include "Rng.h"
+
+static const char *model_names[] = { "er", "powerlaw", "grid" };
+
+// ************************ function prototypes ********************************
+static void generate_er(Graph g, int nV, double degree, int maxWeight,
+                        Rng *r);
+static void generate_power_law(Graph g, int nV, double gamma, int maxWeight,
+                               Rng *r);
+static void generate_grid(Graph g, int side, int maxWeight, Rng *r);
+static int pick_weighted(double *cumulative, int n, Rng *r);
+// ************************ end of function prototypes *************************
+
+int GraphModelFromName(const char *name) {
+	for (int m = GRAPH_ER; m <= GRAPH_GRID; m++) {
+		if (strcmp(name, model_names[m]) == 0) {
+			return m;
+		}
+	}
+	return -1;
+}
+
+const char *GraphModelName(GraphModel model) {
+	return model_names[model];
+}
+
+double GraphModelDefaultParam(GraphModel model) {
+	switch (model) {
+	case GRAPH_ER:        return 4.0;
+	case GRAPH_POWER_LAW: return 2.5;
+	default:              return 0.0;
+	}
+}
+
+Graph GenerateGraph(GraphModel model, int nV, double param, int maxWeight,
+                    uint64_t seed) {
+	assert(nV > 0 && maxWeight > 0);
+	Rng r = RngNew(seed);
+	if (model == GRAPH_GRID) {
+		int side = (int)sqrt((double)nV);
+		if (side < 1) side = 1;
+		Graph g = GraphNew(side * side);
+		generate_grid(g, side, maxWeight, &r);
+		return g;
+	}
+	Graph g = GraphNew(nV);
+	if (model == GRAPH_ER) {
+		generate_er(g, nV, param, maxWeight, &r);
+	}
+	else {
+		generate_power_law(g, nV, param, maxWeight, &r);
+	}
+	return g;
+}
+
+void WriteGraph(FILE *out, Graph g) {
+	int nV = GraphNumVertices(g);
+	fprintf(out, "%d\n", nV);
+	for (Vertex v = 0; v < nV; v++) {
+		for (AdjList e = GraphOutIncident(g, v); e != NULL; e = e->next) {
+			fprintf(out, "%d %d %d\n", v, e->v, e->weight);
+		}
+	}
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+static void generate_er(Graph g, int nV, double degree, int maxWeight,
+                        Rng *r) {
+	if (nV < 2 || degree <= 0) return;
+	double p = degree / (nV - 1);
+	if (p > 1) p = 1;
+	// pairs are numbered u * (nV - 1) + k, where the kth target of u
+	// skips over u itself
+	int64_t pairs = (int64_t)nV * (nV - 1);
+	double log_miss = log(1 - p);
+	int64_t pair = -1;
+	while (true) {
+		if (p < 1) {
+			// number of pairs to skip before the next edge
+			double gap = floor(log(1 - RngDouble(r)) / log_miss);
+			if (gap >= (double)(pairs - pair)) break;
+			pair += (int64_t)gap + 1;
+		}
+		else {
+			pair++;
+		}
+		if (pair >= pairs) break;
+		Vertex u = (Vertex)(pair / (nV - 1));
+		Vertex v = (Vertex)(pair % (nV - 1));
+		if (v >= u) v++;
+		GraphInsertEdge(g, u, v, 1 + RngInt(r, maxWeight));
+	}
+}
+
+static void generate_power_law(Graph g, int nV, double gamma, int maxWeight,
+                               Rng *r) {
+	if (nV < 2) return;
+	assert(gamma > 1);
+	double *cumulative = malloc(nV * sizeof(double));
+	assert(cumulative != NULL);
+	double total = 0;
+	for (int i = 0; i < nV; i++) {
+		total += pow(i + 1, -1 / (gamma - 1));
+		cumulative[i] = total;
+	}
+	int64_t edges = (int64_t)nV * POWER_LAW_DEGREE;
+	for (int64_t e = 0; e < edges; e++) {
+		Vertex u = pick_weighted(cumulative, nV, r);
+		Vertex v = pick_weighted(cumulative, nV, r);
+		int weight = 1 + RngInt(r, maxWeight);
+		if (u != v) {
+			GraphInsertEdge(g, u, v, weight);
+		}
+	}
+	free(cumulative);
+}
+
+static void generate_grid(Graph g, int side, int maxWeight, Rng *r) {
+	for (int row = 0; row < side; row++) {
+		for (int col = 0; col < side; col++) {
+			Vertex v = row * side + col;
+			if (col + 1 < side) {
+				GraphInsertEdge(g, v, v + 1, 1 + RngInt(r, maxWeight));
+				GraphInsertEdge(g, v + 1, v, 1 + RngInt(r, maxWeight));
+			}
+			if (row + 1 < side) {
+				GraphInsertEdge(g, v, v + side, 1 + RngInt(r, maxWeight));
+				GraphInsertEdge(g, v + side, v, 1 + RngInt(r, maxWeight));
+			}
+		}
+	}
+}
+
+// returns a vertex with probability proportional to its weight
+static int pick_weighted(double *cumulative, int n, Rng *r) {
+	double u = RngDouble(r) * cumulative[n - 1];
+	int lo = 0;
+	int hi = n - 1;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (cumulative[mid] > u) {
+			hi = mid;
+		}
+		else {
+			lo = mid + 1;
+		}
+	}
+	return lo;
+}
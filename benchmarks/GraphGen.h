@@ -0,0 +1,51 @@
+// COMP2521 benchmarks
+// GraphGen.h ... interface to the synthetic graph generators
+// z5361442 James Teng
+// Builds random weighted directed graphs through the Graph ADT. Edge weights
+// are uniform in 1..maxWeight. The same arguments always build the same
+// graph.
+//  - GRAPH_ER: Erdős–Rényi, every ordered pair (u, v), u != v, is an edge
+//    with the same probability, chosen to give `param` out edges per vertex
+//    on average.
+//  - GRAPH_POWER_LAW: Chung–Lu, the expected degree of vertex i falls off
+//    as i^(-1 / (gamma - 1)), so the degrees follow a power law with
+//    exponent gamma = `param`; there are about 4 edges per vertex.
+//  - GRAPH_GRID: a square lattice with edges both ways between neighbours;
+//    nV is rounded down to a square and `param` is ignored.
+
+#ifndef GRAPH_GEN_H
+#define GRAPH_GEN_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Graph.h"
+
+typedef enum {
+	GRAPH_ER,
+	GRAPH_POWER_LAW,
+	GRAPH_GRID,
+} GraphModel;
+
+// average out degree of power law graphs
+#define POWER_LAW_DEGREE 4
+
+// Returns the model with the given name ("er", "powerlaw" or "grid"), or
+// -1 if there is no such model
+int GraphModelFromName(const char *name);
+
+// Returns the name of the given model
+const char *GraphModelName(GraphModel model);
+
+// Returns the parameter a model uses when none is given
+double GraphModelDefaultParam(GraphModel model);
+
+// Builds a graph of the given model with (about) nV vertices
+Graph GenerateGraph(GraphModel model, int nV, double param, int maxWeight,
+                    uint64_t seed);
+
+// Writes the graph as its number of vertices followed by one "v w weight"
+// line per edge
+void WriteGraph(FILE *out, Graph g);
+
+#endif
@@ -0,0 +1,161 @@
+// COMP2521 benchmarks
+// benchdict.c ... times the Dictionary ADT on Zipf-distributed words
+// z5361442 James Teng
+// Usage: ./benchdict [-f csv|json] [-r Nreps] [-s Seed] [-V Nvocab]
+//                    [-z Exponent] [-t Ntop] Nwords
+// Build: gcc -O2 -I../assignment1 -I../assignment2 -o benchdict benchdict.c
+//            BenchReport.c CorpusGen.c ../assignment1/Dict.c
+//            ../assignment1/StrArena.c ../assignment1/TopN.c -lm
+// (use DictHash.c or DictAVL.c instead of Dict.c to time another backend).
+// Each run inserts the same Nwords words into an empty Dictionary, looks
+// every one of them up again and then finds the top Ntop words; the three
+// are timed separately. The words are generated before timing starts.
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BenchReport.h"
+#include "CorpusGen.h"
+#include "Dict.h"
+#include "DictExt.h"
+#include "Rng.h"
+#include "WFreq.h"
+
+#define DEFAULT_REPS 5
+#define DEFAULT_SEED 1
+#define DEFAULT_VOCAB 50000
+#define DEFAULT_EXPONENT 1.07
+#define DEFAULT_TOP 100
+
+// ************************ function prototypes ********************************
+static char **generate_words(long nWords, int vocab, double exponent,
+                             uint64_t seed, char **vocab_words);
+static void count_word(char *word, int count, void *ctx);
+// ************************ end of function prototypes *************************
+
+int main(int argc, char *argv[]) {
+	int format = REPORT_CSV;
+	int reps = DEFAULT_REPS;
+	uint64_t seed = DEFAULT_SEED;
+	int vocab = DEFAULT_VOCAB;
+	double exponent = DEFAULT_EXPONENT;
+	int nTop = DEFAULT_TOP;
+
+	// process command-line args; options come first
+	int arg = 1;
+	while (arg + 1 < argc) {
+		if (strcmp(argv[arg], "-f") == 0) {
+			format = ReportFormatFromName(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-r") == 0) {
+			reps = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-s") == 0) {
+			seed = strtoull(argv[arg + 1], NULL, 10);
+		}
+		else if (strcmp(argv[arg], "-V") == 0) {
+			vocab = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-z") == 0) {
+			exponent = atof(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-t") == 0) {
+			nTop = atoi(argv[arg + 1]);
+		}
+		else {
+			break;
+		}
+		arg += 2;
+	}
+	long nWords = arg + 1 == argc ? atol(argv[arg]) : -1;
+	if (nWords < 1 || format < 0 || reps < 1 || vocab < 1 ||
+	    vocab > VOCAB_MAX || exponent <= 0 || nTop < 1) {
+		fprintf(stderr, "Usage: %s [-f csv|json] [-r Nreps] [-s Seed] "
+		                "[-V Nvocab] [-z Exponent] [-t Ntop] Nwords\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	char *vocab_words;
+	char **words = generate_words(nWords, vocab, exponent, seed, &vocab_words);
+	WFreq *wfs = malloc(nTop * sizeof(WFreq));
+	double *insert_s = malloc(reps * sizeof(double));
+	double *find_s = malloc(reps * sizeof(double));
+	double *topn_s = malloc(reps * sizeof(double));
+	assert(wfs != NULL && insert_s != NULL && find_s != NULL && topn_s != NULL);
+
+	long distinct = 0;
+	long found = 0;           // keeps the lookups from being optimised away
+	for (int rep = 0; rep < reps; rep++) {
+		Dict d = DictNew();
+		double start = BenchNow();
+		for (long i = 0; i < nWords; i++) {
+			DictInsert(d, words[i]);
+		}
+		double inserted = BenchNow();
+		for (long i = 0; i < nWords; i++) {
+			found += DictFind(d, words[i]);
+		}
+		double looked_up = BenchNow();
+		DictFindTopN(d, wfs, nTop);
+		double finished = BenchNow();
+
+		insert_s[rep] = inserted - start;
+		find_s[rep] = looked_up - inserted;
+		topn_s[rep] = finished - looked_up;
+		distinct = 0;
+		DictForEach(d, count_word, &distinct);
+		DictFree(d);
+	}
+	if (found == 0) {
+		fprintf(stderr, "no words were found\n");
+	}
+
+	char params[256];
+	snprintf(params, sizeof(params),
+	         "words=%ld distinct=%ld vocab=%d zipf=%g top=%d seed=%llu",
+	         nWords, distinct, vocab, exponent, nTop, (unsigned long long)seed);
+	BenchReport report = BenchReportNew(stdout, format, "dict");
+	BenchReportAdd(report, "DictInsert", params, nWords, reps, insert_s);
+	BenchReportAdd(report, "DictFind", params, nWords, reps, find_s);
+	BenchReportAdd(report, "DictFindTopN", params, distinct, reps, topn_s);
+	BenchReportFree(report);
+
+	free(insert_s);
+	free(find_s);
+	free(topn_s);
+	free(wfs);
+	free(words);
+	free(vocab_words);
+	return EXIT_SUCCESS;
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// returns the sequence of words to insert; the words themselves are stored
+// once each in *vocab_words
+static char **generate_words(long nWords, int vocab, double exponent,
+                             uint64_t seed, char **vocab_words) {
+	*vocab_words = malloc((size_t)vocab * (VOCAB_WORD_MAX + 1));
+	char **words = malloc(nWords * sizeof(char *));
+	assert(*vocab_words != NULL && words != NULL);
+	for (int rank = 0; rank < vocab; rank++) {
+		VocabWord(rank, *vocab_words + (size_t)rank * (VOCAB_WORD_MAX + 1));
+	}
+	Rng r = RngNew(seed);
+	Zipf z = ZipfNew(vocab, exponent);
+	for (long i = 0; i < nWords; i++) {
+		int rank = ZipfSample(z, &r);
+		words[i] = *vocab_words + (size_t)rank * (VOCAB_WORD_MAX + 1);
+	}
+	ZipfFree(z);
+	return words;
+}
+
+static void count_word(char *word, int count, void *ctx) {
+	(void)word;
+	(void)count;
+	(*(long *)ctx)++;
+}
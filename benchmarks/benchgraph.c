@@ -0,0 +1,268 @@
+// COMP2521 benchmarks
+// benchgraph.c ... times the graph analysis functions on synthetic graphs
+// z5361442 James Teng
+// Usage: ./benchgraph [-f csv|json] [-r Nreps] [-s Seed] [-w MaxWeight]
+//                     [-p Param] [-d Nsources] [-x MaxHAC] [-e Epsilon]
+//                     er|powerlaw|grid|all nV
+// Build: gcc -O2 -pthread -I../assignment2 -o benchgraph benchgraph.c
+//            BenchReport.c GraphGen.c ../assignment2/*.c -lm
+// Graph.c and Graph.h are not in this repository: they are the Graph ADT
+// from the assignment 2 starter code, and must be copied into
+// ../assignment2 before building.
+// For each model it builds one graph (see GraphGen.h), then times dijkstra
+// from Nsources sources spread over the vertices, closenessCentrality,
+// betweennessCentrality, and LanceWilliamsHAC with both linkages. HAC needs
+// nV^2 memory, so it is skipped for graphs with more than MaxHAC vertices.
+// With -e it also times betweennessCentralityApprox at that epsilon, and
+// adds its sample count and its error against the exact values to the
+// record's params.
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ApproxCentrality.h"
+#include "BenchReport.h"
+#include "CentralityMeasures.h"
+#include "Dijkstra.h"
+#include "Graph.h"
+#include "GraphGen.h"
+#include "LanceWilliamsHAC.h"
+
+#define DEFAULT_REPS 3
+#define DEFAULT_SEED 1
+#define DEFAULT_MAX_WEIGHT 100
+#define DEFAULT_SOURCES 100
+#define DEFAULT_MAX_HAC 2000
+
+struct Settings {
+	int reps;
+	uint64_t seed;
+	int maxWeight;
+	double param;
+	bool haveParam;
+	int sources;
+	int maxHAC;
+	double epsilon;           // for approximate betweenness, or 0 to skip
+};
+
+// ************************ function prototypes ********************************
+static void bench_model(BenchReport report, GraphModel model, int nV,
+                        struct Settings *s);
+static double time_dijkstra(Graph g, int sources);
+static double time_closeness(Graph g);
+static double time_betweenness(Graph g);
+static double time_hac(Graph g, int method);
+static void bench_approx(BenchReport report, Graph g, const char *params,
+                         struct Settings *s);
+static long count_edges(Graph g);
+// ************************ end of function prototypes *************************
+
+int main(int argc, char *argv[]) {
+	int format = REPORT_CSV;
+	struct Settings s = {
+		DEFAULT_REPS, DEFAULT_SEED, DEFAULT_MAX_WEIGHT, 0, false,
+		DEFAULT_SOURCES, DEFAULT_MAX_HAC, 0
+	};
+
+	// process command-line args; options come first
+	int arg = 1;
+	while (arg + 1 < argc) {
+		if (strcmp(argv[arg], "-f") == 0) {
+			format = ReportFormatFromName(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-r") == 0) {
+			s.reps = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-s") == 0) {
+			s.seed = strtoull(argv[arg + 1], NULL, 10);
+		}
+		else if (strcmp(argv[arg], "-w") == 0) {
+			s.maxWeight = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-p") == 0) {
+			s.param = atof(argv[arg + 1]);
+			s.haveParam = true;
+		}
+		else if (strcmp(argv[arg], "-d") == 0) {
+			s.sources = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-x") == 0) {
+			s.maxHAC = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-e") == 0) {
+			s.epsilon = atof(argv[arg + 1]);
+		}
+		else {
+			break;
+		}
+		arg += 2;
+	}
+	bool all = arg + 2 == argc && strcmp(argv[arg], "all") == 0;
+	int model = arg + 2 == argc && !all ? GraphModelFromName(argv[arg]) : -1;
+	int nV = all || model >= 0 ? atoi(argv[arg + 1]) : 0;
+	if (nV < 1 || format < 0 || s.reps < 1 || s.maxWeight < 1 ||
+	    s.sources < 1 || s.epsilon < 0 || (all && s.haveParam) ||
+	    (model == GRAPH_POWER_LAW && s.haveParam && s.param <= 1)) {
+		fprintf(stderr, "Usage: %s [-f csv|json] [-r Nreps] [-s Seed] "
+		                "[-w MaxWeight] [-p Param] [-d Nsources] [-x MaxHAC] "
+		                "[-e Epsilon] er|powerlaw|grid|all nV\n", argv[0]);
+		fprintf(stderr, "(-p cannot be used with all)\n");
+		exit(EXIT_FAILURE);
+	}
+
+	BenchReport report = BenchReportNew(stdout, format, "graph");
+	if (all) {
+		for (int m = GRAPH_ER; m <= GRAPH_GRID; m++) {
+			bench_model(report, m, nV, &s);
+		}
+	}
+	else {
+		bench_model(report, model, nV, &s);
+	}
+	BenchReportFree(report);
+	return EXIT_SUCCESS;
+}
+
+// ******************************HELPER FUNCTIONS*******************************
+
+// builds one graph of the model and times every function on it
+static void bench_model(BenchReport report, GraphModel model, int nV,
+                        struct Settings *s) {
+	double param = s->haveParam ? s->param : GraphModelDefaultParam(model);
+	double *seconds = malloc(s->reps * sizeof(double));
+	assert(seconds != NULL);
+
+	double start = BenchNow();
+	Graph g = GenerateGraph(model, nV, param, s->maxWeight, s->seed);
+	double built = BenchNow() - start;
+	nV = GraphNumVertices(g);
+	int sources = s->sources < nV ? s->sources : nV;
+
+	char params[256];
+	snprintf(params, sizeof(params),
+	         "model=%s nV=%d nE=%ld param=%g maxWeight=%d seed=%llu",
+	         GraphModelName(model), nV, count_edges(g), param, s->maxWeight,
+	         (unsigned long long)s->seed);
+	BenchReportAdd(report, "GenerateGraph", params, nV, 1, &built);
+
+	for (int rep = 0; rep < s->reps; rep++) {
+		seconds[rep] = time_dijkstra(g, sources);
+	}
+	BenchReportAdd(report, "dijkstra", params, sources, s->reps, seconds);
+
+	for (int rep = 0; rep < s->reps; rep++) {
+		seconds[rep] = time_closeness(g);
+	}
+	BenchReportAdd(report, "closenessCentrality", params, nV, s->reps,
+	               seconds);
+
+	for (int rep = 0; rep < s->reps; rep++) {
+		seconds[rep] = time_betweenness(g);
+	}
+	BenchReportAdd(report, "betweennessCentrality", params, nV, s->reps,
+	               seconds);
+	if (s->epsilon > 0) {
+		bench_approx(report, g, params, s);
+	}
+
+	if (nV <= s->maxHAC) {
+		for (int rep = 0; rep < s->reps; rep++) {
+			seconds[rep] = time_hac(g, SINGLE_LINKAGE);
+		}
+		BenchReportAdd(report, "LanceWilliamsHAC/single", params, nV,
+		               s->reps, seconds);
+		for (int rep = 0; rep < s->reps; rep++) {
+			seconds[rep] = time_hac(g, COMPLETE_LINKAGE);
+		}
+		BenchReportAdd(report, "LanceWilliamsHAC/complete", params, nV,
+		               s->reps, seconds);
+	}
+	else {
+		fprintf(stderr, "skipping LanceWilliamsHAC on %s: %d vertices is "
+		                "more than %d\n", GraphModelName(model), nV, s->maxHAC);
+	}
+
+	GraphFree(g);
+	free(seconds);
+}
+
+// runs dijkstra from `sources` vertices spread evenly over the graph; the
+// results are freed outside the timed part
+static double time_dijkstra(Graph g, int sources) {
+	int nV = GraphNumVertices(g);
+	double total = 0;
+	for (int i = 0; i < sources; i++) {
+		Vertex src = (Vertex)((long)i * nV / sources);
+		double start = BenchNow();
+		ShortestPaths sps = dijkstra(g, src);
+		total += BenchNow() - start;
+		freeShortestPaths(sps);
+	}
+	return total;
+}
+
+static double time_closeness(Graph g) {
+	double start = BenchNow();
+	NodeValues nvs = closenessCentrality(g);
+	double seconds = BenchNow() - start;
+	freeNodeValues(nvs);
+	return seconds;
+}
+
+static double time_betweenness(Graph g) {
+	double start = BenchNow();
+	NodeValues nvs = betweennessCentrality(g);
+	double seconds = BenchNow() - start;
+	freeNodeValues(nvs);
+	return seconds;
+}
+
+// times approximate betweenness, then runs it once more against the exact
+// values to measure its error
+static void bench_approx(BenchReport report, Graph g, const char *params,
+                         struct Settings *s) {
+	ApproxOptions opts = approxDefaultOptions();
+	opts.epsilon = s->epsilon;
+	opts.seed = s->seed;
+	double *seconds = malloc(s->reps * sizeof(double));
+	assert(seconds != NULL);
+	for (int rep = 0; rep < s->reps; rep++) {
+		ApproxReport run;
+		NodeValues nvs = betweennessCentralityApprox(g, opts, &run);
+		seconds[rep] = run.seconds;
+		freeNodeValues(nvs);
+	}
+	BetweennessComparison cmp = betweennessCompareApprox(g, opts);
+
+	char approx_params[512];
+	snprintf(approx_params, sizeof(approx_params),
+	         "%s epsilon=%g delta=%g samples=%d max_error=%.3g "
+	         "mean_error=%.3g outside_epsilon=%d", params, opts.epsilon,
+	         opts.delta, cmp.report.samplesTaken, cmp.maxError, cmp.meanError,
+	         cmp.outsideEpsilon);
+	BenchReportAdd(report, "betweennessCentralityApprox", approx_params,
+	               cmp.report.samplesTaken, s->reps, seconds);
+	free(seconds);
+}
+
+static double time_hac(Graph g, int method) {
+	double start = BenchNow();
+	Dendrogram d = LanceWilliamsHAC(g, method);
+	double seconds = BenchNow() - start;
+	freeDendrogram(d);
+	return seconds;
+}
+
+static long count_edges(Graph g) {
+	long edges = 0;
+	for (Vertex v = 0; v < GraphNumVertices(g); v++) {
+		for (AdjList e = GraphOutIncident(g, v); e != NULL; e = e->next) {
+			edges++;
+		}
+	}
+	return edges;
+}
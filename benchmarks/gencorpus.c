@@ -0,0 +1,52 @@
+// COMP2521 benchmarks
+// gencorpus.c ... writes a synthetic Gutenberg-style book
+// z5361442 James Teng
+// Usage: ./gencorpus [-s Seed] [-V Nvocab] [-z Exponent] Nwords > book.txt
+// Build: gcc -O2 -I../assignment2 -o gencorpus gencorpus.c CorpusGen.c -lm
+// The book can be given straight to tw; the same arguments always write
+// the same book.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CorpusGen.h"
+
+#define DEFAULT_SEED 1
+#define DEFAULT_VOCAB 50000
+#define DEFAULT_EXPONENT 1.07
+
+int main(int argc, char *argv[]) {
+	uint64_t seed = DEFAULT_SEED;
+	int vocab = DEFAULT_VOCAB;
+	double exponent = DEFAULT_EXPONENT;
+
+	// process command-line args; options come first
+	int arg = 1;
+	while (arg + 1 < argc) {
+		if (strcmp(argv[arg], "-s") == 0) {
+			seed = strtoull(argv[arg + 1], NULL, 10);
+		}
+		else if (strcmp(argv[arg], "-V") == 0) {
+			vocab = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-z") == 0) {
+			exponent = atof(argv[arg + 1]);
+		}
+		else {
+			break;
+		}
+		arg += 2;
+	}
+	long words = arg + 1 == argc ? atol(argv[arg]) : -1;
+	if (words < 0 || vocab < 1 || vocab > VOCAB_MAX || exponent <= 0) {
+		fprintf(stderr, "Usage: %s [-s Seed] [-V Nvocab] [-z Exponent] Nwords\n",
+		        argv[0]);
+		fprintf(stderr, "(Nvocab is at most %d)\n", VOCAB_MAX);
+		exit(EXIT_FAILURE);
+	}
+
+	GenerateCorpus(stdout, words, vocab, exponent, seed);
+	return EXIT_SUCCESS;
+}
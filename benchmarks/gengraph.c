@@ -0,0 +1,65 @@
+// COMP2521 benchmarks
+// gengraph.c ... writes a synthetic weighted directed graph
+// z5361442 James Teng
+// Usage: ./gengraph [-s Seed] [-w MaxWeight] [-p Param] er|powerlaw|grid nV
+// Build: gcc -O2 -I../assignment2 -o gengraph gengraph.c GraphGen.c
+//            ../assignment2/Graph.c -lm
+// Graph.c and Graph.h come from the assignment 2 starter code (see
+// benchgraph.c).
+// Writes the number of vertices, then one "v w weight" line per edge. Param
+// is the average out degree for er (default 4) and the degree exponent for
+// powerlaw (default 2.5); see GraphGen.h.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Graph.h"
+#include "GraphGen.h"
+
+#define DEFAULT_SEED 1
+#define DEFAULT_MAX_WEIGHT 100
+
+int main(int argc, char *argv[]) {
+	uint64_t seed = DEFAULT_SEED;
+	int maxWeight = DEFAULT_MAX_WEIGHT;
+	double param = 0;
+	bool haveParam = false;
+
+	// process command-line args; options come first
+	int arg = 1;
+	while (arg + 1 < argc) {
+		if (strcmp(argv[arg], "-s") == 0) {
+			seed = strtoull(argv[arg + 1], NULL, 10);
+		}
+		else if (strcmp(argv[arg], "-w") == 0) {
+			maxWeight = atoi(argv[arg + 1]);
+		}
+		else if (strcmp(argv[arg], "-p") == 0) {
+			param = atof(argv[arg + 1]);
+			haveParam = true;
+		}
+		else {
+			break;
+		}
+		arg += 2;
+	}
+	int model = arg + 2 == argc ? GraphModelFromName(argv[arg]) : -1;
+	int nV = model >= 0 ? atoi(argv[arg + 1]) : 0;
+	if (!haveParam && model >= 0) {
+		param = GraphModelDefaultParam(model);
+	}
+	if (model < 0 || nV < 1 || maxWeight < 1 ||
+	    (model == GRAPH_POWER_LAW && param <= 1)) {
+		fprintf(stderr, "Usage: %s [-s Seed] [-w MaxWeight] [-p Param] "
+		                "er|powerlaw|grid nV\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	Graph g = GenerateGraph(model, nV, param, maxWeight, seed);
+	WriteGraph(stdout, g);
+	GraphFree(g);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+// COMP2521 tests
+// testClosenessTopK.c ... checks closenessTopK against closenessCentrality
+// z5361442 James Teng
+// Usage: ./testClosenessTopK [Seed]
+// Build: gcc -O2 -I../assignment2 -I../benchmarks -o testClosenessTopK
+//            testClosenessTopK.c ../benchmarks/GraphGen.c
+//            ../assignment2/Graph.c ../assignment2/CentralityMeasures.c
+//            ../assignment2/CentralityEngine.c ../assignment2/ClosenessTopK.c
+//            ../assignment2/Dijkstra.c ../assignment2/DijkstraWorkspace.c
+//            ../assignment2/GraphCSR.c ../assignment2/IndexedPQ.c
+//            ../assignment2/PredArena.c -lm
+// (Graph.c and Graph.h come from the assignment 2 starter code; see
+// ../benchmarks/benchgraph.c).
+// On a range of generated graphs, ranks every vertex's closeness from
+// closenessCentrality (decreasing value, then increasing vertex) and checks
+// that closenessTopK and closenessTopKCSR return exactly the first k, for
+// several k. Small weights and disconnected graphs make plenty of ties.
+// Prints the failures and exits with status 1 if there are any.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CentralityMeasures.h"
+#include "ClosenessTopK.h"
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "GraphGen.h"
+
+#define DEFAULT_SEED 1
+
+typedef struct TestGraph {
+	GraphModel model;
+	int nV;
+	double param;
+	int maxWeight;
+} TestGraph;
+
+static const TestGraph GRAPHS[] = {
+	{ GRAPH_ER, 1, 0, 1 },
+	{ GRAPH_ER, 150, 0.5, 2 },
+	{ GRAPH_ER, 200, 1.2, 1 },
+	{ GRAPH_ER, 300, 4, 3 },
+	{ GRAPH_ER, 300, 4, 1000 },
+	{ GRAPH_POWER_LAW, 400, 2.5, 1 },
+	{ GRAPH_GRID, 400, 0, 1 },
+	{ GRAPH_GRID, 400, 0, 5 },
+};
+
+static const int KS[] = { 1, 2, 5, 10, 50 };
+
+static int failures = 0;
+
+static void test_graph(Graph g);
+static void check_top(RankedNode *expected, RankedNode *top, int stored,
+                      int k, int n, const char *form);
+static int ranked_order(const void *a, const void *b);
+
+int main(int argc, char *argv[]) {
+	uint64_t seed = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SEED;
+	int num_graphs = sizeof(GRAPHS) / sizeof(GRAPHS[0]);
+	for (int i = 0; i < num_graphs; i++) {
+		const TestGraph *t = &GRAPHS[i];
+		Graph g = GenerateGraph(t->model, t->nV, t->param, t->maxWeight,
+		                        seed + i);
+		test_graph(g);
+		GraphFree(g);
+	}
+	if (failures > 0) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+	printf("ok\n");
+	return 0;
+}
+
+static void test_graph(Graph g) {
+	int n = GraphNumVertices(g);
+	NodeValues nvs = closenessCentrality(g);
+	RankedNode *expected = malloc(n * sizeof(RankedNode));
+	RankedNode *top = malloc((n + 1) * sizeof(RankedNode));
+	if (expected == NULL || top == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	for (Vertex v = 0; v < n; v++) {
+		expected[v].v = v;
+		expected[v].value = nvs.values[v];
+	}
+	qsort(expected, n, sizeof(RankedNode), ranked_order);
+
+	GraphCSR csr = GraphCSRNew(g);
+	int num_ks = sizeof(KS) / sizeof(KS[0]);
+	for (int i = 0; i <= num_ks; i++) {
+		// the last k asks for more vertices than there are
+		int k = i < num_ks ? KS[i] : n + 1;
+		int stored = closenessTopK(g, k, top);
+		check_top(expected, top, stored, k, n, "closenessTopK");
+		stored = closenessTopKCSR(csr, k, top);
+		check_top(expected, top, stored, k, n, "closenessTopKCSR");
+	}
+	GraphCSRFree(csr);
+	free(expected);
+	free(top);
+	freeNodeValues(nvs);
+}
+
+// the values must be equal, not just close: closenessTopK computes them
+// with the same formula
+static void check_top(RankedNode *expected, RankedNode *top, int stored,
+                      int k, int n, const char *form) {
+	int want = k < n ? k : n;
+	if (stored != want) {
+		failures++;
+		printf("FAIL: %s(k = %d) on %d vertices stored %d, expected %d\n",
+		       form, k, n, stored, want);
+		return;
+	}
+	for (int i = 0; i < stored; i++) {
+		if (top[i].v != expected[i].v || top[i].value != expected[i].value) {
+			failures++;
+			printf("FAIL: %s(k = %d) on %d vertices: rank %d is %d (%.17g), "
+			       "expected %d (%.17g)\n", form, k, n, i, top[i].v,
+			       top[i].value, expected[i].v, expected[i].value);
+			return;
+		}
+	}
+}
+
+// decreasing value, then increasing vertex
+static int ranked_order(const void *a, const void *b) {
+	const RankedNode *node_1 = a;
+	const RankedNode *node_2 = b;
+	if (node_1->value != node_2->value) {
+		return node_1->value > node_2->value ? -1 : 1;
+	}
+	return node_1->v - node_2->v;
+}
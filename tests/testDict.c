@@ -0,0 +1,264 @@
+// COMP2521 tests
+// testDict.c ... checks a Dictionary backend against a sorted word list
+// z5361442 James Teng
+// Usage: ./testDict [Seed]
+// Build: gcc -O2 -I../assignment1 -I../assignment2 -o testDict testDict.c
+//            ../assignment1/Dict.c ../assignment1/StrArena.c
+//            ../assignment1/TopN.c
+// (use DictHash.c or DictAVL.c instead of Dict.c to test another backend;
+// WFreq.h comes from the assignment 1 starter code).
+// Every backend is held to the same reference: the inserted words, sorted
+// and counted. It checks DictFind, DictFindTopN (including that the words
+// it returns survive later inserts), DictForEach, DictAdd and DictClear,
+// on random words, on long words and on sorted input. Prints the failures
+// and exits with status 1 if there are any.
+
+// strdup is POSIX, not C11
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Dict.h"
+#include "DictExt.h"
+#include "Rng.h"
+#include "WFreq.h"
+
+#define DEFAULT_SEED 1
+#define MAX_WORD 40
+#define NUM_WORDS 60000
+#define NUM_SORTED 3000
+
+typedef struct Expected {
+	char *word;
+	int count;
+} Expected;
+
+typedef struct Check {
+	int failures;
+} Check;
+
+static char **random_words(Rng *r, int n);
+static Expected *count_words(char **words, int n, int *distinct);
+static int expected_order(const void *a, const void *b);
+static int word_order(const void *a, const void *b);
+static void check(Check *c, bool ok, const char *what, const char *word);
+static void check_counts(Check *c, Dict d, Expected *exp, int distinct);
+static void check_top(Check *c, Dict d, Expected *exp, int distinct, int n);
+static void check_for_each(Check *c, Dict d, int distinct, long total);
+static void sum_word(char *word, int count, void *ctx);
+static void free_words(char **words, int n);
+
+int main(int argc, char *argv[]) {
+	uint64_t seed = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SEED;
+	Rng r = RngNew(seed);
+	Check c = { 0 };
+
+	// random words, some of them added several at a time
+	char **words = random_words(&r, NUM_WORDS);
+	Dict d = DictNew();
+	for (int i = 0; i < NUM_WORDS; i++) {
+		int run = 1;
+		while (i + run < NUM_WORDS && strcmp(words[i + run], words[i]) == 0) {
+			run++;
+		}
+		if (run > 1) {
+			DictAdd(d, words[i], run);
+			i += run - 1;
+		}
+		else {
+			DictInsert(d, words[i]);
+		}
+	}
+	int distinct;
+	Expected *exp = count_words(words, NUM_WORDS, &distinct);
+	check_counts(&c, d, exp, distinct);
+	check(&c, DictFind(d, "notinthedictionary") == 0, "absent word found",
+	      "notinthedictionary");
+	check_top(&c, d, exp, distinct, 1);
+	check_top(&c, d, exp, distinct, 25);
+	check_top(&c, d, exp, distinct, distinct + 5);
+	check_for_each(&c, d, distinct, NUM_WORDS);
+
+	// the words DictFindTopN returns must outlive later inserts
+	WFreq top[25];
+	int stored = DictFindTopN(d, top, 25);
+	char **more = random_words(&r, NUM_WORDS);
+	for (int i = 0; i < NUM_WORDS; i++) {
+		DictInsert(d, more[i]);
+	}
+	for (int i = 0; i < stored; i++) {
+		check(&c, strcmp(top[i].word, exp[i].word) == 0,
+		      "top word changed by later inserts", exp[i].word);
+	}
+	free_words(more, NUM_WORDS);
+
+	// a cleared Dictionary is empty and can be filled again
+	DictClear(d);
+	check(&c, DictFind(d, exp[0].word) == 0, "word survived DictClear",
+	      exp[0].word);
+	check(&c, DictFindTopN(d, top, 25) == 0, "DictClear left words", "");
+	check_for_each(&c, d, 0, 0);
+	for (int i = 0; i < NUM_WORDS / 4; i++) {
+		DictInsert(d, words[i]);
+	}
+	free(exp);
+	exp = count_words(words, NUM_WORDS / 4, &distinct);
+	check_counts(&c, d, exp, distinct);
+	check_top(&c, d, exp, distinct, 25);
+	DictFree(d);
+	free(exp);
+
+	// sorted input
+	qsort(words, NUM_SORTED, sizeof(char *), word_order);
+	d = DictNew();
+	for (int i = 0; i < NUM_SORTED; i++) {
+		DictInsert(d, words[i]);
+	}
+	exp = count_words(words, NUM_SORTED, &distinct);
+	check_counts(&c, d, exp, distinct);
+	check_top(&c, d, exp, distinct, distinct);
+	DictFree(d);
+	free(exp);
+	free_words(words, NUM_WORDS);
+
+	if (c.failures > 0) {
+		printf("%d failures\n", c.failures);
+		return 1;
+	}
+	printf("ok\n");
+	return 0;
+}
+
+// returns n random words. Most are short words over a few letters, so they
+// repeat; one in eight is up to MAX_WORD letters long. Runs of the same
+// word are made often enough to exercise DictAdd.
+static char **random_words(Rng *r, int n) {
+	char **words = malloc(n * sizeof(char *));
+	if (words == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	for (int i = 0; i < n; i++) {
+		if (i > 0 && RngInt(r, 16) == 0) {
+			words[i] = strdup(words[i - 1]);
+		}
+		else {
+			bool is_long = RngInt(r, 8) == 0;
+			int length = is_long ? 1 + RngInt(r, MAX_WORD) : 1 + RngInt(r, 4);
+			int letters = is_long ? 26 : 5;
+			words[i] = malloc(length + 1);
+			for (int j = 0; j < length; j++) {
+				words[i][j] = 'a' + RngInt(r, letters);
+			}
+			words[i][length] = '\0';
+		}
+		if (words[i] == NULL) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+	}
+	return words;
+}
+
+// returns the distinct words among the first n, with their counts, in the
+// order DictFindTopN must return them
+static Expected *count_words(char **words, int n, int *distinct) {
+	char **sorted = malloc(n * sizeof(char *));
+	Expected *exp = malloc(n * sizeof(Expected));
+	if (sorted == NULL || exp == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	memcpy(sorted, words, n * sizeof(char *));
+	qsort(sorted, n, sizeof(char *), word_order);
+	*distinct = 0;
+	for (int i = 0; i < n; i++) {
+		if (*distinct > 0 && strcmp(exp[*distinct - 1].word, sorted[i]) == 0) {
+			exp[*distinct - 1].count++;
+		}
+		else {
+			exp[*distinct].word = sorted[i];
+			exp[*distinct].count = 1;
+			(*distinct)++;
+		}
+	}
+	qsort(exp, *distinct, sizeof(Expected), expected_order);
+	free(sorted);
+	return exp;
+}
+
+// decreasing count, then increasing word
+static int expected_order(const void *a, const void *b) {
+	const Expected *exp_1 = a;
+	const Expected *exp_2 = b;
+	if (exp_1->count != exp_2->count) {
+		return exp_1->count > exp_2->count ? -1 : 1;
+	}
+	return strcmp(exp_1->word, exp_2->word);
+}
+
+static int word_order(const void *a, const void *b) {
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static void check(Check *c, bool ok, const char *what, const char *word) {
+	if (!ok) {
+		c->failures++;
+		if (c->failures <= 10) {
+			printf("FAIL: %s (\"%s\")\n", what, word);
+		}
+	}
+}
+
+static void check_counts(Check *c, Dict d, Expected *exp, int distinct) {
+	for (int i = 0; i < distinct; i++) {
+		check(c, DictFind(d, exp[i].word) == exp[i].count, "wrong count",
+		      exp[i].word);
+	}
+}
+
+static void check_top(Check *c, Dict d, Expected *exp, int distinct, int n) {
+	WFreq *top = malloc(n * sizeof(WFreq));
+	if (top == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	int stored = DictFindTopN(d, top, n);
+	int want = n < distinct ? n : distinct;
+	check(c, stored == want, "DictFindTopN stored the wrong number", "");
+	for (int i = 0; i < stored && i < want; i++) {
+		check(c, strcmp(top[i].word, exp[i].word) == 0 &&
+		      top[i].freq == exp[i].count, "wrong top word", exp[i].word);
+	}
+	free(top);
+}
+
+struct Sums {
+	int words;
+	long total;
+};
+
+static void check_for_each(Check *c, Dict d, int distinct, long total) {
+	struct Sums sums = { 0, 0 };
+	DictForEach(d, sum_word, &sums);
+	check(c, sums.words == distinct, "DictForEach visited the wrong words", "");
+	check(c, sums.total == total, "DictForEach counts don't add up", "");
+}
+
+static void sum_word(char *word, int count, void *ctx) {
+	(void)word;
+	struct Sums *sums = ctx;
+	sums->words++;
+	sums->total += count;
+}
+
+static void free_words(char **words, int n) {
+	for (int i = 0; i < n; i++) {
+		free(words[i]);
+	}
+	free(words);
+}
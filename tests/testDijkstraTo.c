@@ -0,0 +1,239 @@
+// COMP2521 tests
+// testDijkstraTo.c ... checks the point-to-point and radius queries
+// z5361442 James Teng
+// Usage: ./testDijkstraTo [Seed]
+// Build: gcc -O2 -I../assignment2 -I../benchmarks -o testDijkstraTo
+//            testDijkstraTo.c ../benchmarks/GraphGen.c ../assignment2/Graph.c
+//            ../assignment2/Dijkstra.c ../assignment2/DijkstraWorkspace.c
+//            ../assignment2/GraphCSR.c ../assignment2/IndexedPQ.c
+//            ../assignment2/PredArena.c -lm
+// (Graph.c and Graph.h come from the assignment 2 starter code; see
+// ../benchmarks/benchgraph.c).
+// On a range of generated graphs, answers queries with every form of
+// dijkstraTo and dijkstraWithin (Graph, snapshot, and a workspace reused
+// across queries) and compares them with a full dijkstra run from the same
+// source. Vertices on the shortest paths to the target, or within the
+// radius, must have the same dist and pred; the rest must be unreached.
+// The pred lists must also be in the same order with the binary heap. Set
+// DIJKSTRA_QUEUE=bucket to test the bucket queue. Prints the failures and
+// exits with status 1 if there are any.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Dijkstra.h"
+#include "DijkstraVariants.h"
+#include "DijkstraWorkspace.h"
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "GraphGen.h"
+#include "IndexedPQ.h"
+#include "Rng.h"
+
+#define DEFAULT_SEED 1
+#define QUERIES 60
+
+typedef struct TestGraph {
+	GraphModel model;
+	int nV;
+	double param;
+	int maxWeight;
+} TestGraph;
+
+// sparse graphs leave many pairs unreachable; small weights make ties
+static const TestGraph GRAPHS[] = {
+	{ GRAPH_ER, 200, 0.8, 3 },
+	{ GRAPH_ER, 300, 3, 1 },
+	{ GRAPH_ER, 300, 4, 100 },
+	{ GRAPH_POWER_LAW, 400, 2.5, 5 },
+	{ GRAPH_GRID, 400, 0, 2 },
+};
+
+typedef struct Check {
+	int failures;
+	bool ordered;     // pred lists must be in the same order
+} Check;
+
+static void test_graph(Check *c, Graph g, Rng *r);
+static void check_to(Check *c, ShortestPaths full, ShortestPaths to,
+                     Vertex dest, const char *form);
+static void check_within(Check *c, ShortestPaths full, ShortestPaths within,
+                         int radius, const char *form);
+static void check_vertex(Check *c, ShortestPaths full, ShortestPaths part,
+                         Vertex v, bool kept, const char *form);
+static bool same_preds(PredNode *a, PredNode *b, bool ordered);
+
+int main(int argc, char *argv[]) {
+	uint64_t seed = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SEED;
+	Rng r = RngNew(seed);
+	Check c = { 0, IPQDefaultKind() == IPQ_BINARY_HEAP };
+	int num_graphs = sizeof(GRAPHS) / sizeof(GRAPHS[0]);
+	for (int i = 0; i < num_graphs; i++) {
+		const TestGraph *t = &GRAPHS[i];
+		Graph g = GenerateGraph(t->model, t->nV, t->param, t->maxWeight,
+		                        seed + i);
+		test_graph(&c, g, &r);
+		GraphFree(g);
+	}
+	if (c.failures > 0) {
+		printf("%d failures\n", c.failures);
+		return 1;
+	}
+	printf("ok\n");
+	return 0;
+}
+
+// answers QUERIES random queries with each form in turn
+static void test_graph(Check *c, Graph g, Rng *r) {
+	int n = GraphNumVertices(g);
+	GraphCSR csr = GraphCSRNew(g);
+	DijkstraWorkspace ws = dijkstraWorkspaceNew(n);
+	for (int q = 0; q < QUERIES; q++) {
+		Vertex src = RngInt(r, n);
+		// a few queries from a vertex to itself
+		Vertex dest = q % 10 == 0 ? src : RngInt(r, n);
+		ShortestPaths full = dijkstra(g, src);
+
+		ShortestPaths to;
+		const char *form;
+		switch (q % 4) {
+		case 0:
+			to = dijkstraTo(g, src, dest);
+			form = "dijkstraTo";
+			break;
+		case 1:
+			to = dijkstraToCSR(csr, src, dest);
+			form = "dijkstraToCSR";
+			break;
+		case 2:
+			dijkstraToInto(g, src, dest, ws);
+			to = dijkstraWorkspacePaths(ws);
+			form = "dijkstraToInto";
+			break;
+		default:
+			dijkstraCSRToInto(csr, src, dest, ws);
+			to = dijkstraWorkspacePaths(ws);
+			form = "dijkstraCSRToInto";
+		}
+		check_to(c, full, to, dest, form);
+		freeShortestPaths(to);
+
+		// a radius around the distance to dest, so it cuts through paths
+		int radius = full.dist[dest] != INFINITY ? full.dist[dest] : 0;
+		radius += RngInt(r, 3) - 1;
+		if (radius < 0) radius = 0;
+		ShortestPaths within;
+		switch (q % 4) {
+		case 0:
+			within = dijkstraWithin(g, src, radius);
+			form = "dijkstraWithin";
+			break;
+		case 1:
+			within = dijkstraWithinCSR(csr, src, radius);
+			form = "dijkstraWithinCSR";
+			break;
+		case 2:
+			dijkstraWithinInto(g, src, radius, ws);
+			within = dijkstraWorkspacePaths(ws);
+			form = "dijkstraWithinInto";
+			break;
+		default:
+			dijkstraCSRWithinInto(csr, src, radius, ws);
+			within = dijkstraWorkspacePaths(ws);
+			form = "dijkstraCSRWithinInto";
+		}
+		check_within(c, full, within, radius, form);
+		freeShortestPaths(within);
+		freeShortestPaths(full);
+	}
+	dijkstraWorkspaceFree(ws);
+	GraphCSRFree(csr);
+}
+
+// the vertices on shortest paths to dest are the ones dest is reached from
+// through the full run's pred lists
+static void check_to(Check *c, ShortestPaths full, ShortestPaths to,
+                     Vertex dest, const char *form) {
+	int n = full.numNodes;
+	bool *on_path = calloc(n, sizeof(bool));
+	Vertex *stack = malloc(n * sizeof(Vertex));
+	if (on_path == NULL || stack == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	int stack_size = 0;
+	if (full.dist[dest] != INFINITY) {
+		on_path[dest] = true;
+		stack[stack_size++] = dest;
+	}
+	while (stack_size > 0) {
+		Vertex v = stack[--stack_size];
+		for (PredNode *curr = full.pred[v]; curr != NULL; curr = curr->next) {
+			if (!on_path[curr->v]) {
+				on_path[curr->v] = true;
+				stack[stack_size++] = curr->v;
+			}
+		}
+	}
+	for (Vertex v = 0; v < n; v++) {
+		bool kept = on_path[v] || v == full.src;
+		check_vertex(c, full, to, v, kept, form);
+	}
+	free(on_path);
+	free(stack);
+}
+
+static void check_within(Check *c, ShortestPaths full, ShortestPaths within,
+                         int radius, const char *form) {
+	for (Vertex v = 0; v < full.numNodes; v++) {
+		check_vertex(c, full, within, v, full.dist[v] <= radius, form);
+	}
+}
+
+// a kept vertex must match the full run; any other must be unreached
+static void check_vertex(Check *c, ShortestPaths full, ShortestPaths part,
+                         Vertex v, bool kept, const char *form) {
+	bool ok;
+	if (kept) {
+		ok = part.dist[v] == full.dist[v] &&
+		     same_preds(part.pred[v], full.pred[v], c->ordered);
+	}
+	else {
+		ok = part.dist[v] == INFINITY && part.pred[v] == NULL;
+	}
+	if (!ok) {
+		c->failures++;
+		if (c->failures <= 10) {
+			printf("FAIL: %s from %d: vertex %d has dist %d, expected %d\n",
+			       form, full.src, v, part.dist[v],
+			       kept ? full.dist[v] : INFINITY);
+		}
+	}
+}
+
+static bool same_preds(PredNode *a, PredNode *b, bool ordered) {
+	if (ordered) {
+		for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+			if (a->v != b->v) return false;
+		}
+		return a == NULL && b == NULL;
+	}
+	// the same vertices in any order: every vertex of a is in b, and the
+	// lists are the same length
+	int length_a = 0;
+	int length_b = 0;
+	for (PredNode *curr = b; curr != NULL; curr = curr->next) {
+		length_b++;
+	}
+	for (; a != NULL; a = a->next) {
+		length_a++;
+		PredNode *curr = b;
+		while (curr != NULL && curr->v != a->v) {
+			curr = curr->next;
+		}
+		if (curr == NULL) return false;
+	}
+	return length_a == length_b;
+}
@@ -0,0 +1,241 @@
+// COMP2521 tests
+// testLanceWilliamsHAC.c ... checks the HAC variants against a reference
+// z5361442 James Teng
+// Usage: ./testLanceWilliamsHAC [Seed]
+// Build: gcc -O2 -I../assignment2 -I../benchmarks -o testLanceWilliamsHAC
+//            testLanceWilliamsHAC.c ../benchmarks/GraphGen.c
+//            ../assignment2/Graph.c ../assignment2/LanceWilliamsHAC.c
+//            ../assignment2/LanceWilliamsHACSparse.c ../assignment2/GraphCSR.c
+//            -lm
+// (Graph.c and Graph.h come from the assignment 2 starter code; see
+// ../benchmarks/benchgraph.c).
+// The reference is the original LanceWilliamsHAC: a full V x V matrix of
+// distances, scanned row by row for the smallest one before every merge.
+// On a range of generated graphs, LanceWilliamsHAC and LanceWilliamsHACCSR
+// must build the same Dendrogram as the reference for both methods, and
+// LanceWilliamsHACSparse and LanceWilliamsHACSparseCSR the same one as the
+// reference for single linkage. Sparse graphs leave clusters that aren't
+// connected; small weights make ties. Prints the failures and exits with
+// status 1 if there are any.
+
+#include <float.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "GraphGen.h"
+#include "LanceWilliamsHAC.h"
+#include "LanceWilliamsHACVariants.h"
+
+#define DEFAULT_SEED 1
+#define INFINITY DBL_MAX
+
+typedef struct TestGraph {
+	GraphModel model;
+	int nV;
+	double param;
+	int maxWeight;
+} TestGraph;
+
+static const TestGraph GRAPHS[] = {
+	{ GRAPH_ER, 1, 0, 1 },
+	{ GRAPH_ER, 2, 0, 1 },
+	{ GRAPH_ER, 60, 0.3, 3 },
+	{ GRAPH_ER, 100, 1, 2 },
+	{ GRAPH_ER, 120, 3, 1 },
+	{ GRAPH_ER, 150, 6, 1000 },
+	{ GRAPH_POWER_LAW, 150, 2.5, 4 },
+	{ GRAPH_GRID, 144, 0, 3 },
+};
+
+static int failures = 0;
+
+static void test_graph(Graph g, const TestGraph *t);
+static void check(Dendrogram expected, Dendrogram d, const char *form,
+                  const TestGraph *t);
+static bool same_dendrogram(Dendrogram a, Dendrogram b);
+static Dendrogram reference_hac(Graph g, int method);
+static double edge_weight(Graph g, Vertex i, Vertex j);
+
+int main(int argc, char *argv[]) {
+	uint64_t seed = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SEED;
+	int num_graphs = sizeof(GRAPHS) / sizeof(GRAPHS[0]);
+	for (int i = 0; i < num_graphs; i++) {
+		const TestGraph *t = &GRAPHS[i];
+		Graph g = GenerateGraph(t->model, t->nV, t->param, t->maxWeight,
+		                        seed + i);
+		test_graph(g, t);
+		GraphFree(g);
+	}
+	if (failures > 0) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+	printf("ok\n");
+	return 0;
+}
+
+static void test_graph(Graph g, const TestGraph *t) {
+	GraphCSR csr = GraphCSRNew(g);
+	Dendrogram expected = reference_hac(g, SINGLE_LINKAGE);
+	check(expected, LanceWilliamsHAC(g, SINGLE_LINKAGE),
+	      "LanceWilliamsHAC(single)", t);
+	check(expected, LanceWilliamsHACCSR(csr, SINGLE_LINKAGE),
+	      "LanceWilliamsHACCSR(single)", t);
+	check(expected, LanceWilliamsHACSparse(g), "LanceWilliamsHACSparse", t);
+	check(expected, LanceWilliamsHACSparseCSR(csr),
+	      "LanceWilliamsHACSparseCSR", t);
+	freeDendrogram(expected);
+
+	expected = reference_hac(g, COMPLETE_LINKAGE);
+	check(expected, LanceWilliamsHAC(g, COMPLETE_LINKAGE),
+	      "LanceWilliamsHAC(complete)", t);
+	check(expected, LanceWilliamsHACCSR(csr, COMPLETE_LINKAGE),
+	      "LanceWilliamsHACCSR(complete)", t);
+	freeDendrogram(expected);
+	GraphCSRFree(csr);
+}
+
+// frees d once it is checked
+static void check(Dendrogram expected, Dendrogram d, const char *form,
+                  const TestGraph *t) {
+	if (!same_dendrogram(expected, d)) {
+		failures++;
+		printf("FAIL: %s on %s(%d, %g, %d)\n", form, GraphModelName(t->model),
+		       t->nV, t->param, t->maxWeight);
+	}
+	freeDendrogram(d);
+}
+
+// the same shape, with the same leaves in the same places
+static bool same_dendrogram(Dendrogram a, Dendrogram b) {
+	if (a == NULL || b == NULL) {
+		return a == b;
+	}
+	bool is_leaf = a->left == NULL && a->right == NULL;
+	if (is_leaf && a->vertex != b->vertex) {
+		return false;
+	}
+	return same_dendrogram(a->left, b->left) &&
+	       same_dendrogram(a->right, b->right);
+}
+
+//*****************************REFERENCE****************************************
+
+// The original algorithm, kept as simple as it was. The distance between
+// two vertices is 1 / the larger weight of the edges between them, and
+// INFINITY if there are none. Before each merge the whole matrix is scanned
+// row by row for the first smallest distance; if there are none left, the
+// two lowest indexed clusters are merged. The merged cluster takes the
+// lower index.
+static Dendrogram reference_hac(Graph g, int method) {
+	int n = GraphNumVertices(g);
+	double **dist = malloc(n * sizeof(double *));
+	Dendrogram *cluster = malloc(n * sizeof(Dendrogram));
+	if (dist == NULL || cluster == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	for (int i = 0; i < n; i++) {
+		dist[i] = malloc(n * sizeof(double));
+		cluster[i] = malloc(sizeof(DNode));
+		if (dist[i] == NULL || cluster[i] == NULL) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+		cluster[i]->vertex = i;
+		cluster[i]->left = cluster[i]->right = NULL;
+		for (int j = 0; j < n; j++) {
+			double weight = i == j ? 0 : edge_weight(g, i, j);
+			dist[i][j] = weight > 0 ? 1.0 / weight : INFINITY;
+		}
+	}
+
+	for (int merge = 0; merge < n - 1; merge++) {
+		int v1 = -1;
+		int v2 = -1;
+		double min_dist = INFINITY;
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				if (i != j && cluster[i] != NULL && cluster[j] != NULL &&
+				    dist[i][j] < min_dist) {
+					min_dist = dist[i][j];
+					v1 = i < j ? i : j;
+					v2 = i < j ? j : i;
+				}
+			}
+		}
+		if (v1 == -1) {
+			for (int i = 0; i < n; i++) {
+				if (cluster[i] == NULL) continue;
+				if (v1 == -1) {
+					v1 = i;
+				}
+				else if (v2 == -1) {
+					v2 = i;
+				}
+			}
+		}
+
+		Dendrogram merged = malloc(sizeof(DNode));
+		if (merged == NULL) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+		merged->vertex = -1;
+		merged->left = cluster[v1];
+		merged->right = cluster[v2];
+		cluster[v1] = merged;
+		cluster[v2] = NULL;
+
+		// an INFINITY distance never wins, whatever the method
+		for (int k = 0; k < n; k++) {
+			if (k == v1 || k == v2 || cluster[k] == NULL) continue;
+			double dist_1 = dist[v1][k];
+			double dist_2 = dist[v2][k];
+			double d;
+			if (dist_1 == INFINITY) {
+				d = dist_2;
+			}
+			else if (dist_2 == INFINITY) {
+				d = dist_1;
+			}
+			else if (method == SINGLE_LINKAGE) {
+				d = dist_1 < dist_2 ? dist_1 : dist_2;
+			}
+			else {
+				d = dist_1 > dist_2 ? dist_1 : dist_2;
+			}
+			dist[v1][k] = dist[k][v1] = d;
+		}
+	}
+
+	Dendrogram root = n > 0 ? cluster[0] : NULL;
+	for (int i = 0; i < n; i++) {
+		free(dist[i]);
+	}
+	free(dist);
+	free(cluster);
+	return root;
+}
+
+// the larger weight of the edges between i and j either way, or 0
+static double edge_weight(Graph g, Vertex i, Vertex j) {
+	double weight = 0;
+	for (AdjList curr = GraphOutIncident(g, i); curr != NULL;
+	     curr = curr->next) {
+		if (curr->v == j && curr->weight > weight) {
+			weight = curr->weight;
+		}
+	}
+	for (AdjList curr = GraphOutIncident(g, j); curr != NULL;
+	     curr = curr->next) {
+		if (curr->v == i && curr->weight > weight) {
+			weight = curr->weight;
+		}
+	}
+	return weight;
+}